@@ -33,11 +33,19 @@
 #ifndef SLAPSEGIII_H_
 #define SLAPSEGIII_H_
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <memory>
+#include <memory_resource>
 #include <set>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /** Slap Fingerprint Segmentation Evaluation III namespace. */
@@ -188,6 +196,205 @@ namespace SlapSegIII
 		    const Orientation orientation,
 		    const std::vector<std::byte> &pixels);
 
+		/**
+		 * @brief
+		 * SlapImage constructor, taking ownership of pixels.
+		 *
+		 * @param width
+		 * Width of the image.
+		 * @param height
+		 * Height of the image.
+		 * @param ppi
+		 * Resolution of the image in pixels per inch.
+		 * @param kind
+		 * The kind of capture employed to create the image.
+		 * @param captureTechnology
+		 * The capture technology used to create the image.
+		 * @param orientation
+		 * The orientation of fingers in the image.
+		 * @param pixels
+		 * `width` * `height` bytes of image data, as described in the
+		 * copying constructor. Moved into this object without
+		 * copying.
+		 */
+		SlapImage(
+		    const uint16_t width,
+		    const uint16_t height,
+		    const uint16_t ppi,
+		    const Kind kind,
+		    const CaptureTechnology captureTechnology,
+		    const Orientation orientation,
+		    std::vector<std::byte> &&pixels);
+
+		/**
+		 * @brief
+		 * SlapImage constructor, referencing pixels owned elsewhere.
+		 *
+		 * @param width
+		 * Width of the image.
+		 * @param height
+		 * Height of the image.
+		 * @param ppi
+		 * Resolution of the image in pixels per inch.
+		 * @param kind
+		 * The kind of capture employed to create the image.
+		 * @param captureTechnology
+		 * The capture technology used to create the image.
+		 * @param orientation
+		 * The orientation of fingers in the image.
+		 * @param pixelView
+		 * `width` * `height` bytes of image data, laid out as
+		 * described for `pixels`. Not copied.
+		 * @param pixelOwner
+		 * Optional handle keeping the memory referenced by
+		 * `pixelView` alive (e.g., a capture buffer, a mapped file,
+		 * or a pooled buffer). When empty, the caller guarantees that
+		 * `pixelView` outlives this object and all its copies.
+		 *
+		 * @note
+		 * `pixels` is left empty. Use getPixels() to read image data.
+		 * Only pass such images to implementations whose
+		 * Interface::supportsPixelViews() returns true.
+		 */
+		SlapImage(
+		    const uint16_t width,
+		    const uint16_t height,
+		    const uint16_t ppi,
+		    const Kind kind,
+		    const CaptureTechnology captureTechnology,
+		    const Orientation orientation,
+		    const std::span<const std::byte> pixelView,
+		    std::shared_ptr<const void> pixelOwner = {});
+
+		/**
+		 * @brief
+		 * Obtain the image data, regardless of how it is stored.
+		 *
+		 * @return
+		 * `width` * `height` bytes of image data: `pixelView` if this
+		 * object references external memory, otherwise `pixels`.
+		 *
+		 * @note
+		 * This method never copies image data.
+		 */
+		std::span<const std::byte>
+		getPixels()
+		    const
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Obtain this image at a lower resolution.
+		 *
+		 * @param level
+		 * Number of times to halve the resolution. Level 0 is this
+		 * image.
+		 *
+		 * @return
+		 * Image referencing pixels of the requested level, with
+		 * `width`, `height`, and `ppi` halved (rounding down) `level`
+		 * times and all other metadata copied from this image.
+		 *
+		 * @throw std::invalid_argument
+		 * `level` would produce an image with no pixels, or this image
+		 * does not hold `width` * `height` bytes.
+		 *
+		 * @note
+		 * Each level is produced from the level above it by
+		 * averaging 2x2 blocks of pixels. Levels are built on first
+		 * request, then cached and shared by copies of this object
+		 * made after any level was requested, so implementations and
+		 * the orientation step may request them freely. This method
+		 * is thread-safe.
+		 *
+		 * @warning
+		 * Cached levels are not rebuilt if image data is modified
+		 * after a level was requested.
+		 */
+		SlapImage
+		getPyramidLevel(
+		    const uint8_t level)
+		    const;
+
+		/**
+		 * @brief
+		 * Obtain the distance between the starts of consecutive rows.
+		 *
+		 * @return
+		 * `rowStride`, or `width` if `rowStride` is 0.
+		 */
+		std::size_t
+		getRowStride()
+		    const
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Obtain one row of the image.
+		 *
+		 * @param row
+		 * Row to obtain, less than `height`. Row 0 is the top row of
+		 * the region of interest.
+		 *
+		 * @return
+		 * `width` bytes of image data, beginning with the pixel at
+		 * column `xOffset` of buffer row `yOffset` + `row`.
+		 *
+		 * @note
+		 * Only valid when hasValidLayout() is true.
+		 */
+		std::span<const std::byte>
+		getRow(
+		    const uint16_t row)
+		    const
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Determine if the image data is tightly packed.
+		 *
+		 * @return
+		 * true if getPixels() holds exactly the `width` * `height`
+		 * bytes of the image, row after row, false if rows are padded
+		 * or the image is a region of a larger buffer.
+		 */
+		bool
+		isPacked()
+		    const
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Determine if the image data is consistent with `width`,
+		 * `height`, `rowStride`, `xOffset`, and `yOffset`.
+		 *
+		 * @return
+		 * true if every row of the region of interest lies within
+		 * getPixels() and within its buffer row, false otherwise.
+		 */
+		bool
+		hasValidLayout()
+		    const
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Obtain a tightly packed copy of the region of interest.
+		 *
+		 * @return
+		 * `width` * `height` bytes of image data.
+		 *
+		 * @throw std::invalid_argument
+		 * hasValidLayout() is false.
+		 *
+		 * @note
+		 * For implementations that do not support row strides. Prefer
+		 * getRow(), which does not copy.
+		 */
+		std::vector<std::byte>
+		getPackedPixels()
+		    const;
+
 		/** Width of the image. */
 		uint16_t width{};
 		/** Height of the image. */
@@ -210,8 +417,101 @@ namespace SlapSegIII
 		 * @note
 		 * To pass pixels to a C-style array, invoke pixel's `data()`
 		 * method (`pixels.data()`).
+		 *
+		 * @warning
+		 * Empty when this object references external memory. Prefer
+		 * getPixels(), which is valid for all constructors.
+		 *
+		 * @warning
+		 * When `rowStride`, `xOffset`, or `yOffset` are set, image
+		 * data is a larger buffer containing this image. Use
+		 * getRow() or getPackedPixels() to read such images.
 		 */
 		std::vector<std::byte> pixels{};
+		/**
+		 * Image data owned elsewhere, laid out as described for
+		 * `pixels`. Empty when image data is stored in `pixels`.
+		 */
+		std::span<const std::byte> pixelView{};
+		/** Keeps the memory referenced by `pixelView` alive. */
+		std::shared_ptr<const void> pixelOwner{};
+		/**
+		 * @brief
+		 * Number of bytes between the starts of consecutive rows of
+		 * image data.
+		 *
+		 * @details
+		 * 0 (the default) means `width`: rows are not padded. When
+		 * nonzero, image data holds at least `yOffset` + `height` rows
+		 * of `rowStride` bytes each (the last row may be short), and
+		 * pixel (x, y) of this image is at byte
+		 * (`yOffset` + y) * `rowStride` + `xOffset` + x.
+		 */
+		uint32_t rowStride{0};
+		/** First column of image data that is part of this image. */
+		uint16_t xOffset{0};
+		/** First row of image data that is part of this image. */
+		uint16_t yOffset{0};
+
+		/** Lower-resolution levels of an image. */
+		struct Pyramid;
+
+		/** Pyramid created on first use, shared by copies. */
+		class LazyPyramid
+		{
+		public:
+			/** Constructor that does not create a Pyramid. */
+			LazyPyramid()
+			    noexcept;
+
+			/**
+			 * @brief
+			 * Copy constructor.
+			 *
+			 * @note
+			 * Shares the Pyramid of `other`, if created.
+			 */
+			LazyPyramid(
+			    const LazyPyramid &other)
+			    noexcept;
+
+			/**
+			 * @brief
+			 * Copy assignment operator.
+			 *
+			 * @note
+			 * Shares the Pyramid of `other`, if created.
+			 */
+			LazyPyramid&
+			operator=(
+			    const LazyPyramid &other)
+			    noexcept;
+
+			/**
+			 * @brief
+			 * Obtain the Pyramid, creating it if needed.
+			 *
+			 * @return
+			 * Pyramid shared by this object and its copies.
+			 *
+			 * @note
+			 * This method is thread-safe. Concurrent first
+			 * calls create one Pyramid.
+			 */
+			std::shared_ptr<Pyramid>
+			get()
+			    const;
+
+		private:
+			/** Pyramid, or nullptr until first needed */
+			mutable std::atomic<std::shared_ptr<Pyramid>> pyramid{};
+		};
+
+		/**
+		 * Lower-resolution levels built by getPyramidLevel(), shared
+		 * by copies of this object.
+		 */
+		LazyPyramid pyramid{};
 	};
 
 	/** Representation of a segmentation position. */
@@ -243,7 +543,7 @@ namespace SlapSegIII
 			 */
 			Result(
 			    const Code code = Code::Success,
-			    const std::string &message = "");
+			    std::string message = "");
 
 			/** Status from segmenting an individual finger. */
 			Code code{};
@@ -281,7 +581,7 @@ namespace SlapSegIII
 		    const Coordinate &tr,
 		    const Coordinate &bl,
 		    const Coordinate &br,
-		    const Result result = {});
+		    Result result = {});
 
 		/** Friction ridge generalized position */
 		FrictionRidgeGeneralizedPosition frgp{};
@@ -340,7 +640,12 @@ namespace SlapSegIII
 			/** Failure: This method is not implemented. */
 			NotImplemented,
 			/** Failure: Other reason. See error message. */
-			VendorDefined
+			VendorDefined,
+			/**
+			 * Failure: Work was cancelled or its deadline passed
+			 * before it completed.
+			 */
+			TimedOut
 		};
 
 		/**
@@ -362,9 +667,8 @@ namespace SlapSegIII
 		 */
 		ReturnStatus(
 		    const Code code = Code::Success,
-		    const std::set<SlapImage::Deficiency>
-		    &imageDeficiencies = {},
-		    const std::string &message = "");
+		    std::set<SlapImage::Deficiency> imageDeficiencies = {},
+		    std::string message = "");
 
 		/** Returned status code. */
 		Code code{};
@@ -377,104 +681,779 @@ namespace SlapSegIII
 		std::string message{};
 	};
 
-	/** Information identifying this submission. */
-	struct SubmissionIdentification
+	/**
+	 * @brief
+	 * Obtain a copy of a message that lives until the process exits.
+	 *
+	 * @param message
+	 * Message to intern.
+	 *
+	 * @return
+	 * View of a copy of `message`, truncated to
+	 * CompactSegmentationPositions::MessageCapacity characters, that
+	 * remains valid until the process exits. Equal messages return
+	 * views of the same copy. Empty once 256 distinct messages have
+	 * been interned.
+	 *
+	 * @note
+	 * Copies are kept in fixed storage, so memory used does not grow
+	 * with the number of calls. Messages that may differ with each
+	 * call should be copied with
+	 * CompactSegmentationPositions::copyMessage() instead. This
+	 * method is thread-safe.
+	 */
+	std::string_view
+	internMessage(
+	    const std::string_view message);
+
+	/** Set of SlapImage::Deficiency stored without allocation. */
+	class DeficiencyMask
 	{
-		/** Default constructor. */
-		SubmissionIdentification();
+	public:
+		/** Constructor for an empty set. */
+		DeficiencyMask()
+		    noexcept;
 
 		/**
 		 * @brief
-		 * SubmissionIdentification constructor.
+		 * Constructor.
 		 *
-		 * @param libraryIdentifier
-		 * Identifier for this submission.
-		 * @param version
-		 * Unique version number for this submission.
-		 * @param marketingIdentifier
-		 * Optional marketing name for this submission.
+		 * @param deficiencies
+		 * Deficiencies to include.
 		 */
-		SubmissionIdentification(
-		    const std::string &libraryIdentifier,
-		    const uint16_t version,
-		    const std::string &marketingIdentifier = "");
+		DeficiencyMask(
+		    const std::set<SlapImage::Deficiency> &deficiencies)
+		    noexcept;
 
 		/**
 		 * @brief
-		 * Version number for this submission.
+		 * Add a deficiency.
 		 *
-		 * @details
-		 * Must be unique with every new submission. Must match the
-		 * final underscore-delimited token of the filename of the
-		 * core library.
+		 * @param deficiency
+		 * Deficiency to add.
 		 */
-		uint16_t version{};
+		void
+		set(
+		    const SlapImage::Deficiency deficiency)
+		    noexcept;
+
 		/**
 		 * @brief
-		 * Identifier for this submission.
+		 * Remove a deficiency.
 		 *
-		 * @details
-		 * Should be the same for all submissions from the same
-		 * organization. Case-sensitive. Must match the regular
-		 * expression "[:alnum:]+". Must be the same as the second
-		 * underscore-delimited token of the filename of the core
-		 * library.
+		 * @param deficiency
+		 * Deficiency to remove.
 		 */
-		std::string libraryIdentifier{};
+		void
+		reset(
+		    const SlapImage::Deficiency deficiency)
+		    noexcept;
+
 		/**
 		 * @brief
-		 * Marketing name for this submission.
+		 * Determine if a deficiency is included.
 		 *
-		 * @details
-		 * Optional. Must match the regular expression "[[:graph:] ]*".
+		 * @param deficiency
+		 * Deficiency to check.
+		 *
+		 * @return
+		 * true if `deficiency` is included, false otherwise.
 		 */
-		std::string marketingIdentifier{};
+		bool
+		test(
+		    const SlapImage::Deficiency deficiency)
+		    const
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Determine if no deficiencies are included.
+		 *
+		 * @return
+		 * true if the set is empty, false otherwise.
+		 */
+		bool
+		none()
+		    const
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Obtain included deficiencies as a std::set.
+		 *
+		 * @return
+		 * Included deficiencies.
+		 */
+		std::set<SlapImage::Deficiency>
+		toSet()
+		    const;
 
+	private:
+		/** Bit (1 << Deficiency) is set for included deficiencies */
+		uint8_t bits{0};
 	};
 
 	/**
 	 * @brief
-	 * Slap Fingerprint Segmentation III interface.
+	 * SegmentationPosition that does not own its message.
 	 *
 	 * @details
-	 * Participants must inherit from this class and implement all methods.
+	 * `message` must remain valid for as long as the caller may read
+	 * it: string literals and messages returned by internMessage()
+	 * are suitable.
 	 */
-	class Interface
+	struct CompactSegmentationPosition
 	{
-	public:
+		/** Default CompactSegmentationPosition constructor. */
+		CompactSegmentationPosition()
+		    noexcept;
+
 		/**
 		 * @brief
-		 * Obtain identification and version information for this
-		 * submission.
+		 * CompactSegmentationPosition constructor.
 		 *
-		 * @return
-		 * SubmissionIdentification with identification details about
-		 * this submission.
+		 * @param frgp
+		 * FrictionRidgeGeneralizedPosition for the bounded finger.
+		 * @param tl
+		 * Top-left coordinate.
+		 * @param tr
+		 * Top-right coordinate.
+		 * @param bl
+		 * Bottom-left coordinate.
+		 * @param br
+		 * Bottom-right coordinate.
+		 * @param code
+		 * Status from segmenting the finger.
+		 * @param message
+		 * Message providing insight into code's value.
 		 *
-		 * @note
-		 * This method shall return instantly.
+		 * @see SegmentationPosition::SegmentationPosition()
 		 */
-		virtual
-		SubmissionIdentification
-		getIdentification()
-		    const = 0;
+		CompactSegmentationPosition(
+		    const FrictionRidgeGeneralizedPosition frgp,
+		    const Coordinate &tl,
+		    const Coordinate &tr,
+		    const Coordinate &bl,
+		    const Coordinate &br,
+		    const SegmentationPosition::Result::Code code =
+		    SegmentationPosition::Result::Code::Success,
+		    const std::string_view message = {})
+		    noexcept;
 
 		/**
 		 * @brief
-		 * Obtain features supported by this implementation.
+		 * Constructor from a SegmentationPosition.
 		 *
-		 * @return
-		 * A tuple whose first member is the set of supported
-		 * SlapImage::Kind and whose second member indicates the
-		 * presence of an implementation of
-		 * Interface::determineOrientation().
+		 * @param position
+		 * Position to convert.
 		 *
 		 * @note
-		 * Returned set of SlapImage::Kind must include at least one
-		 * SlapImage::Kind.
+		 * A non-empty message is interned with internMessage(), so
+		 * it may be truncated, or dropped once that storage is full.
+		 */
+		explicit CompactSegmentationPosition(
+		    const SegmentationPosition &position);
+
+		/**
+		 * @brief
+		 * Convert to a SegmentationPosition.
 		 *
-		 * @note
-		 * This method shall return instantly.
+		 * @return
+		 * SegmentationPosition with a copy of message.
+		 */
+		SegmentationPosition
+		toSegmentationPosition()
+		    const;
+
+		/** Friction ridge generalized position */
+		FrictionRidgeGeneralizedPosition frgp{};
+		/** Top-left coordinate */
+		Coordinate tl{};
+		/** Top-right coordinate */
+		Coordinate tr{};
+		/** Bottom-left coordinate */
+		Coordinate bl{};
+		/** Bottom-right coordinate */
+		Coordinate br{};
+		/** Status from segmenting the finger. */
+		SegmentationPosition::Result::Code code{};
+		/** Message providing insight into code's value. */
+		std::string_view message{};
+	};
+
+	/**
+	 * @brief
+	 * Fixed-capacity collection of CompactSegmentationPosition.
+	 *
+	 * @details
+	 * Holds as many positions as there are fingers in a slap, without
+	 * allocating. Messages may be copied into fixed-size storage
+	 * owned by the collection with copyMessage().
+	 */
+	class CompactSegmentationPositions
+	{
+	public:
+		/** Maximum number of positions held. */
+		static constexpr std::size_t Capacity{4};
+		/** Maximum length of a message kept by copyMessage(). */
+		static constexpr std::size_t MessageCapacity{128};
+
+		/** Constructor for an empty collection. */
+		CompactSegmentationPositions()
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Copy constructor.
+		 *
+		 * @note
+		 * Messages of `other` that were copied with copyMessage()
+		 * are viewed in the storage of the new collection.
+		 */
+		CompactSegmentationPositions(
+		    const CompactSegmentationPositions &other)
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Copy assignment operator.
+		 *
+		 * @note
+		 * Messages of `other` that were copied with copyMessage()
+		 * are viewed in the storage of this collection.
+		 */
+		CompactSegmentationPositions&
+		operator=(
+		    const CompactSegmentationPositions &other)
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Add a position.
+		 *
+		 * @param position
+		 * Position to add.
+		 *
+		 * @throw std::length_error
+		 * Collection already holds Capacity positions.
+		 */
+		void
+		push_back(
+		    const CompactSegmentationPosition &position);
+
+		/** Remove all positions and copied messages. */
+		void
+		clear()
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Copy a message into storage owned by this collection.
+		 *
+		 * @param message
+		 * Message to copy.
+		 *
+		 * @return
+		 * View of a copy of `message`, truncated to
+		 * MessageCapacity characters. The view remains valid until
+		 * clear() is called or this collection is assigned to or
+		 * destroyed. Empty once Capacity + 1 messages have been
+		 * copied since the last clear().
+		 */
+		std::string_view
+		copyMessage(
+		    const std::string_view message)
+		    noexcept;
+
+		/** @return Number of positions held. */
+		std::size_t
+		size()
+		    const
+		    noexcept;
+
+		/** @return true if no positions are held. */
+		bool
+		empty()
+		    const
+		    noexcept;
+
+		/** @return Iterator to the first position. */
+		const CompactSegmentationPosition*
+		begin()
+		    const
+		    noexcept;
+
+		/** @return Iterator past the last position. */
+		const CompactSegmentationPosition*
+		end()
+		    const
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Access a position.
+		 *
+		 * @param index
+		 * Index of position, less than size().
+		 *
+		 * @return
+		 * Position at `index`.
+		 */
+		const CompactSegmentationPosition&
+		operator[](
+		    const std::size_t index)
+		    const
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Convert to SegmentationPositions.
+		 *
+		 * @return
+		 * SegmentationPositions with copies of messages.
+		 */
+		std::vector<SegmentationPosition>
+		toSegmentationPositions()
+		    const;
+
+	private:
+		/** Storage for positions */
+		std::array<CompactSegmentationPosition, Capacity> positions{};
+		/** Number of valid entries in positions */
+		std::size_t count{0};
+		/** Storage for messages: one per position, and a status */
+		std::array<std::array<char, MessageCapacity>, Capacity + 1>
+		    messages{};
+		/** Number of used entries in messages */
+		std::size_t messageCount{0};
+	};
+
+	/**
+	 * @brief
+	 * ReturnStatus that does not allocate.
+	 *
+	 * @details
+	 * `message` must remain valid for as long as the caller may read
+	 * it: string literals and messages returned by internMessage()
+	 * are suitable.
+	 */
+	struct CompactReturnStatus
+	{
+		/**
+		 * @brief
+		 * CompactReturnStatus constructor.
+		 *
+		 * @param code
+		 * Status code from a method.
+		 * @param imageDeficiencies
+		 * If code is RequestRecapture or RequestRecaptureWithAttempt,
+		 * one or more Deficiency describing why a recapture should
+		 * be requested.
+		 * @param message
+		 * Message providing insight into code's value.
+		 */
+		CompactReturnStatus(
+		    const ReturnStatus::Code code = ReturnStatus::Code::Success,
+		    const DeficiencyMask imageDeficiencies = {},
+		    const std::string_view message = {})
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Constructor from a ReturnStatus.
+		 *
+		 * @param status
+		 * Status to convert.
+		 *
+		 * @note
+		 * A non-empty message is interned with internMessage(), so
+		 * it may be truncated, or dropped once that storage is full.
+		 */
+		explicit CompactReturnStatus(
+		    const ReturnStatus &status);
+
+		/**
+		 * @brief
+		 * Convert to a ReturnStatus.
+		 *
+		 * @return
+		 * ReturnStatus with a copy of message.
+		 */
+		ReturnStatus
+		toReturnStatus()
+		    const;
+
+		/** Returned status code. */
+		ReturnStatus::Code code{};
+		/**
+		 * Deficiencies with a SlapImage (required only when code is
+		 * RequestRecapture or RequestRecaptureWithAttempt).
+		 */
+		DeficiencyMask imageDeficiencies{};
+		/** Explanatory message (optional). */
+		std::string_view message{};
+	};
+
+	/** Concurrency characteristics of an implementation. */
+	struct ConcurrencyCapabilities
+	{
+		/**
+		 * @brief
+		 * ConcurrencyCapabilities constructor.
+		 *
+		 * @param reentrant
+		 * Whether Interface methods may be called concurrently on a
+		 * single instance.
+		 * @param maxConcurrentCalls
+		 * Maximum number of concurrent calls supported by a single
+		 * instance, or 0 for no limit.
+		 * @param threadsPerCall
+		 * Number of threads used internally by a single call.
+		 *
+		 * @note
+		 * The default values describe an implementation that must
+		 * not be called concurrently and uses one thread per call.
+		 */
+		ConcurrencyCapabilities(
+		    const bool reentrant = false,
+		    const uint16_t maxConcurrentCalls = 1,
+		    const uint16_t threadsPerCall = 1)
+		    noexcept;
+
+		/**
+		 * Whether Interface::segment() and
+		 * Interface::determineOrientation() may be called
+		 * concurrently from several threads on a single instance.
+		 */
+		bool reentrant{false};
+		/**
+		 * Maximum number of concurrent calls supported by a single
+		 * instance, or 0 for no limit. Ignored unless `reentrant`.
+		 */
+		uint16_t maxConcurrentCalls{1};
+		/**
+		 * Number of threads used internally by a single call to
+		 * Interface::segment() or Interface::determineOrientation().
+		 */
+		uint16_t threadsPerCall{1};
+	};
+
+	/** Memory needed by an implementation to process images. */
+	struct ResourceRequirements
+	{
+		/**
+		 * @brief
+		 * ResourceRequirements constructor.
+		 *
+		 * @param peakScratchBytes
+		 * Largest amount of temporary memory allocated during a
+		 * single call.
+		 * @param workingSetBytes
+		 * Memory held by an instance between calls.
+		 *
+		 * @note
+		 * The default values indicate that requirements are unknown.
+		 */
+		ResourceRequirements(
+		    const uint64_t peakScratchBytes = 0,
+		    const uint64_t workingSetBytes = 0)
+		    noexcept;
+
+		/**
+		 * Largest amount of temporary memory, in bytes, allocated
+		 * during a single call to Interface::segment() or
+		 * Interface::determineOrientation(), excluding the image
+		 * itself. 0 if unknown.
+		 */
+		uint64_t peakScratchBytes{0};
+		/**
+		 * Memory, in bytes, held by an instance between calls (e.g.,
+		 * models and lookup tables). 0 if unknown.
+		 */
+		uint64_t workingSetBytes{0};
+	};
+
+	/**
+	 * @brief
+	 * Cooperative cancellation state shared between a caller and the
+	 * work it requested.
+	 *
+	 * @details
+	 * Copies of a CancellationToken share state: cancelling one cancels
+	 * all. Implementations are expected to consult isCancelled() at
+	 * convenient points and return ReturnStatus::Code::TimedOut when it
+	 * is true.
+	 */
+	class CancellationToken
+	{
+	public:
+		/** Clock on which deadlines are expressed. */
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		 * @brief
+		 * CancellationToken constructor.
+		 *
+		 * @param deadline
+		 * Time after which work should stop. Defaults to no deadline.
+		 */
+		CancellationToken(
+		    const Clock::time_point deadline =
+		    Clock::time_point::max());
+
+		/**
+		 * @brief
+		 * Request that work stop as soon as possible.
+		 *
+		 * @note
+		 * Safe to call from any thread.
+		 */
+		void
+		cancel()
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Determine if work should stop.
+		 *
+		 * @return
+		 * true if cancel() has been called on this or a copy of this
+		 * token, or if the deadline has passed.
+		 */
+		bool
+		isCancelled()
+		    const
+		    noexcept;
+
+		/**
+		 * @brief
+		 * Obtain the time after which work should stop.
+		 *
+		 * @return
+		 * Deadline, or Clock::time_point::max() if there is none.
+		 */
+		Clock::time_point
+		getDeadline()
+		    const
+		    noexcept;
+
+	private:
+		/** Time after which work should stop. */
+		Clock::time_point deadline{};
+		/** Whether cancel() has been called, shared by copies. */
+		std::shared_ptr<std::atomic<bool>> cancelled{};
+	};
+
+	/** Information identifying this submission. */
+	struct SubmissionIdentification
+	{
+		/** Default constructor. */
+		SubmissionIdentification();
+
+		/**
+		 * @brief
+		 * SubmissionIdentification constructor.
+		 *
+		 * @param libraryIdentifier
+		 * Identifier for this submission.
+		 * @param version
+		 * Unique version number for this submission.
+		 * @param marketingIdentifier
+		 * Optional marketing name for this submission.
+		 */
+		SubmissionIdentification(
+		    const std::string &libraryIdentifier,
+		    const uint16_t version,
+		    const std::string &marketingIdentifier = "");
+
+		/**
+		 * @brief
+		 * Version number for this submission.
+		 *
+		 * @details
+		 * Must be unique with every new submission. Must match the
+		 * final underscore-delimited token of the filename of the
+		 * core library.
+		 */
+		uint16_t version{};
+		/**
+		 * @brief
+		 * Identifier for this submission.
+		 *
+		 * @details
+		 * Should be the same for all submissions from the same
+		 * organization. Case-sensitive. Must match the regular
+		 * expression "[:alnum:]+". Must be the same as the second
+		 * underscore-delimited token of the filename of the core
+		 * library.
+		 */
+		std::string libraryIdentifier{};
+		/**
+		 * @brief
+		 * Marketing name for this submission.
+		 *
+		 * @details
+		 * Optional. Must match the regular expression "[[:graph:] ]*".
+		 */
+		std::string marketingIdentifier{};
+
+	};
+
+	/**
+	 * @brief
+	 * Segmentation of a single image delivered incrementally as bands
+	 * of rows.
+	 *
+	 * @details
+	 * Obtained from Interface::beginSegmentation(). Callers push every
+	 * row of the image, top to bottom, with one or more calls to
+	 * pushRows(), then call finish() once. Implementations may begin
+	 * work (e.g., foreground detection) on early bands while later
+	 * bands are still being captured.
+	 *
+	 * @note
+	 * A SegmentationStream must not outlive the Interface that
+	 * created it.
+	 */
+	class SegmentationStream
+	{
+	public:
+		/**
+		 * @brief
+		 * Provide the next rows of the image.
+		 *
+		 * @param rows
+		 * One or more complete rows of `width` bytes each,
+		 * immediately following the rows previously pushed. Not
+		 * referenced after this method returns.
+		 *
+		 * @return
+		 * Information about the result of executing the method. If
+		 * code is not ReturnStatus::Code::Success, the caller may
+		 * stop pushing rows and call finish().
+		 *
+		 * @throw std::invalid_argument
+		 * `rows` is not a whole number of rows, or would extend past
+		 * the last row of the image.
+		 */
+		virtual
+		ReturnStatus
+		pushRows(
+		    const std::span<const std::byte> rows) = 0;
+
+		/**
+		 * @brief
+		 * Obtain segmentation positions once all rows are pushed.
+		 *
+		 * @return
+		 * See Interface::segment(const SlapImage&).
+		 *
+		 * @note
+		 * This method shall return within the time limit of
+		 * Interface::segment(), and should return much faster when
+		 * rows were processed as they were pushed.
+		 */
+		virtual
+		std::tuple<ReturnStatus, std::vector<SegmentationPosition>>
+		finish() = 0;
+
+		/** Destructor. */
+		virtual ~SegmentationStream();
+	};
+
+	/**
+	 * @brief
+	 * Segmentation of consecutive frames of the same slap.
+	 *
+	 * @details
+	 * Obtained from Interface::beginSession(). Live capture produces
+	 * many near-identical frames until one is accepted. Sessions let
+	 * implementations use results from previous frames to update
+	 * segmentation incrementally instead of searching each frame.
+	 *
+	 * @note
+	 * A SegmentationSession must not outlive the Interface that
+	 * created it.
+	 */
+	class SegmentationSession
+	{
+	public:
+		/**
+		 * @brief
+		 * Discover fingerprint segmentation positions within the next
+		 * frame.
+		 *
+		 * @param frame
+		 * Next frame of the slap. Same kind, dimensions, and
+		 * resolution as previous frames of this session.
+		 *
+		 * @return
+		 * See Interface::segment(const SlapImage&).
+		 */
+		virtual
+		std::tuple<ReturnStatus, std::vector<SegmentationPosition>>
+		segmentFrame(
+		    const SlapImage &frame) = 0;
+
+		/**
+		 * @brief
+		 * Discard information from previous frames.
+		 *
+		 * @note
+		 * Called when the subject lifts or substantially moves their
+		 * hand, so that the next frame is searched in full.
+		 */
+		virtual
+		void
+		reset() = 0;
+
+		/** Destructor. */
+		virtual ~SegmentationSession();
+	};
+
+	/**
+	 * @brief
+	 * Slap Fingerprint Segmentation III interface.
+	 *
+	 * @details
+	 * Participants must inherit from this class and implement all methods.
+	 */
+	class Interface
+	{
+	public:
+		/**
+		 * @brief
+		 * Obtain identification and version information for this
+		 * submission.
+		 *
+		 * @return
+		 * SubmissionIdentification with identification details about
+		 * this submission.
+		 *
+		 * @note
+		 * This method shall return instantly.
+		 */
+		virtual
+		SubmissionIdentification
+		getIdentification()
+		    const = 0;
+
+		/**
+		 * @brief
+		 * Obtain features supported by this implementation.
+		 *
+		 * @return
+		 * A tuple whose first member is the set of supported
+		 * SlapImage::Kind and whose second member indicates the
+		 * presence of an implementation of
+		 * Interface::determineOrientation().
+		 *
+		 * @note
+		 * Returned set of SlapImage::Kind must include at least one
+		 * SlapImage::Kind.
+		 *
+		 * @note
+		 * This method shall return instantly.
 		 * @note
 		 * If an orientation determination algorithm is not present
 		 * (e.g., the second member of the return value from this
@@ -487,6 +1466,177 @@ namespace SlapSegIII
 		getSupported()
 		    const = 0;
 
+		/**
+		 * @brief
+		 * Whether this implementation reads image data with
+		 * SlapImage::getPixels().
+		 *
+		 * @return
+		 * true if images passed to this implementation may reference
+		 * pixels owned elsewhere, leaving SlapImage::pixels empty.
+		 *
+		 * @note
+		 * This method shall return instantly.
+		 *
+		 * @note
+		 * The default implementation returns false, so callers copy
+		 * image data into SlapImage::pixels, as implementations
+		 * written for earlier versions of this API expect.
+		 */
+		virtual
+		bool
+		supportsPixelViews()
+		    const;
+
+		/**
+		 * @brief
+		 * Prepare to process images.
+		 *
+		 * @param kinds
+		 * Kinds of images that will be processed.
+		 *
+		 * @return
+		 * Information about the result of executing the method.
+		 * Callers shall not process images if ReturnStatus.code is
+		 * not ReturnStatus::Code::Success.
+		 *
+		 * @note
+		 * Called once, after getImplementation() and before the first
+		 * call to segment() or determineOrientation(). Implementations
+		 * should load models and build tables needed for `kinds` here,
+		 * so that the first call is not slower than the rest. Callers
+		 * may fork() after this method returns, so memory initialized
+		 * here can be shared copy-on-write by all processes.
+		 *
+		 * @note
+		 * The default implementation does nothing and returns
+		 * ReturnStatus::Code::Success.
+		 */
+		virtual
+		ReturnStatus
+		prepare(
+		    const std::set<SlapImage::Kind> &kinds);
+
+		/**
+		 * @brief
+		 * Notification that the calling process is about to fork().
+		 *
+		 * @note
+		 * Implementations should quiesce internal threads and avoid
+		 * writing to memory that should remain shared between
+		 * processes. Called before every fork() by the caller.
+		 *
+		 * @note
+		 * The default implementation does nothing.
+		 */
+		virtual
+		void
+		preFork();
+
+		/**
+		 * @brief
+		 * Notification, in the parent process, that fork() returned.
+		 *
+		 * @note
+		 * Called after every fork() preceded by preFork(), whether
+		 * or not fork() succeeded. The default implementation does
+		 * nothing.
+		 */
+		virtual
+		void
+		postForkParent();
+
+		/**
+		 * @brief
+		 * Notification, in the child process, that fork() returned.
+		 *
+		 * @note
+		 * Only the thread that called fork() exists in the child.
+		 * Implementations should recreate internal threads here,
+		 * before any other method is called in the child. The
+		 * default implementation does nothing.
+		 */
+		virtual
+		void
+		postForkChild();
+
+		/**
+		 * @brief
+		 * Obtain concurrency characteristics of this implementation.
+		 *
+		 * @return
+		 * Whether this implementation is reentrant, how many
+		 * concurrent calls a single instance supports, and how many
+		 * threads each call uses.
+		 *
+		 * @note
+		 * This method shall return instantly.
+		 *
+		 * @note
+		 * Callers use this information to choose between threads and
+		 * processes, and to avoid oversubscribing cores. The default
+		 * implementation returns a default-constructed
+		 * ConcurrencyCapabilities, which causes callers to only use
+		 * processes.
+		 */
+		virtual
+		ConcurrencyCapabilities
+		getConcurrencyCapabilities()
+		    const;
+
+		/**
+		 * @brief
+		 * Obtain memory needed to process images.
+		 *
+		 * @param kind
+		 * Kind of images to be processed.
+		 * @param ppi
+		 * Resolution of images to be processed.
+		 *
+		 * @return
+		 * Peak scratch memory and working set size when processing
+		 * images of `kind` at `ppi`.
+		 *
+		 * @note
+		 * This method shall return instantly.
+		 *
+		 * @note
+		 * Callers use this information to avoid starting more
+		 * processes than memory allows, and to size memory passed to
+		 * setMemoryResource(). The default implementation returns a
+		 * default-constructed ResourceRequirements (unknown).
+		 */
+		virtual
+		ResourceRequirements
+		getResourceRequirements(
+		    const SlapImage::Kind kind,
+		    const uint16_t ppi)
+		    const;
+
+		/**
+		 * @brief
+		 * Provide memory for temporaries allocated during calls.
+		 *
+		 * @param resource
+		 * Memory resource from which temporaries may be allocated, or
+		 * nullptr to stop using a previously provided resource.
+		 *
+		 * @note
+		 * Memory allocated from `resource` during a call must be
+		 * deallocated before that call returns. `resource` is not
+		 * synchronized: it is only provided when calls on this
+		 * instance are not concurrent, and remains valid until this
+		 * method is called again.
+		 *
+		 * @note
+		 * Using `resource` is optional. The default implementation
+		 * ignores it.
+		 */
+		virtual
+		void
+		setMemoryResource(
+		    std::pmr::memory_resource *resource);
+
 		/**
 		 * @brief
 		 * Discover fingerprint segmentation positions within a slap
@@ -529,6 +1679,102 @@ namespace SlapSegIII
 		segment(
 		    const SlapImage &image) = 0;
 
+		/**
+		 * @brief
+		 * Discover fingerprint segmentation positions within a slap
+		 * image, stopping early if requested.
+		 *
+		 * @param image
+		 * Image data and metadata to segment.
+		 * @param cancellation
+		 * Token indicating when the caller no longer needs a result.
+		 *
+		 * @return
+		 * See Interface::segment(const SlapImage&). If work stops
+		 * because `cancellation` was cancelled or its deadline
+		 * passed, ReturnStatus.code shall be
+		 * ReturnStatus::Code::TimedOut.
+		 *
+		 * @note
+		 * The default implementation returns
+		 * ReturnStatus::Code::TimedOut if `cancellation` is already
+		 * cancelled, and otherwise calls
+		 * Interface::segment(const SlapImage&) without checking
+		 * `cancellation` again.
+		 */
+		virtual
+		std::tuple<ReturnStatus, std::vector<SegmentationPosition>>
+		segmentWithCancellation(
+		    const SlapImage &image,
+		    const CancellationToken &cancellation);
+
+		/**
+		 * @brief
+		 * Discover fingerprint segmentation positions within a slap
+		 * image, writing them into caller-owned storage.
+		 *
+		 * @param image
+		 * Image data and metadata to segment.
+		 * @param positions
+		 * Storage to receive segmentation positions. Cleared before
+		 * positions are added. Callers may reuse the same storage for
+		 * every call.
+		 *
+		 * @return
+		 * Information about the result of executing the method. See
+		 * Interface::segment(const SlapImage&) for the meaning of
+		 * returned values.
+		 *
+		 * @note
+		 * Implementations overriding this method should not allocate
+		 * memory per call to return results: messages should be
+		 * string literals, be returned from internMessage(), or be
+		 * copied with CompactSegmentationPositions::copyMessage().
+		 *
+		 * @note
+		 * The default implementation calls
+		 * Interface::segment(const SlapImage&) and converts the
+		 * result, copying messages into `positions`. If more than
+		 * CompactSegmentationPositions::Capacity positions are
+		 * returned, only the first are kept and ReturnStatus.code
+		 * is ReturnStatus::Code::VendorDefined.
+		 */
+		virtual
+		CompactReturnStatus
+		segmentInto(
+		    const SlapImage &image,
+		    CompactSegmentationPositions &positions);
+
+		/**
+		 * @brief
+		 * Discover fingerprint segmentation positions within several
+		 * slap images.
+		 *
+		 * @param images
+		 * Image data and metadata to segment.
+		 *
+		 * @return
+		 * One tuple per element of `images`, in the same order, each
+		 * as would be returned from Interface::segment() for that
+		 * image.
+		 *
+		 * @note
+		 * The default implementation calls Interface::segment() on
+		 * each image in turn. Implementations that can amortize
+		 * per-call setup, process same-sized images together, or
+		 * overlap work between images may override this method.
+		 *
+		 * @note
+		 * All requirements of Interface::segment() apply to each
+		 * image. The time limits of Table 8 of the %SlapSegIII Test
+		 * Plan apply to the average time per image.
+		 */
+		virtual
+		std::vector<std::tuple<ReturnStatus,
+		    std::vector<SegmentationPosition>>>
+		segmentBatch(
+		    const std::span<const SlapImage> images);
+
 		/**
 		 * @brief
 		 * Determine the hand orientation of a slap image.
@@ -561,6 +1807,142 @@ namespace SlapSegIII
 		determineOrientation(
 		    const SlapImage &image) = 0;
 
+		/**
+		 * @brief
+		 * Determine the hand orientation of a slap image, stopping
+		 * early if requested.
+		 *
+		 * @param image
+		 * Image data and metadata.
+		 * @param cancellation
+		 * Token indicating when the caller no longer needs a result.
+		 *
+		 * @return
+		 * See Interface::determineOrientation(const SlapImage&). If
+		 * work stops because `cancellation` was cancelled or its
+		 * deadline passed, ReturnStatus.code shall be
+		 * ReturnStatus::Code::TimedOut.
+		 *
+		 * @note
+		 * The default implementation returns
+		 * ReturnStatus::Code::TimedOut if `cancellation` is already
+		 * cancelled, and otherwise calls
+		 * Interface::determineOrientation(const SlapImage&) without
+		 * checking `cancellation` again.
+		 */
+		virtual
+		std::tuple<ReturnStatus, SlapImage::Orientation>
+		determineOrientationWithCancellation(
+		    const SlapImage &image,
+		    const CancellationToken &cancellation);
+
+		/**
+		 * @brief
+		 * Determine the hand orientation of a slap image and discover
+		 * fingerprint segmentation positions within it, sharing
+		 * preprocessing between the two.
+		 *
+		 * @param image
+		 * Image data and metadata.
+		 *
+		 * @return
+		 * A tuple whose first member is the value that would be
+		 * returned from Interface::segment() and whose second member
+		 * is the value that would be returned from
+		 * Interface::determineOrientation().
+		 *
+		 * @warning
+		 * Do not consult the `orientation` member of `image` when
+		 * determining orientation. It will be default-initialized
+		 * only.
+		 *
+		 * @note
+		 * The default implementation calls
+		 * Interface::determineOrientation(), then calls
+		 * Interface::segment() on a copy of `image` whose
+		 * `orientation` is the hypothesized orientation (or the
+		 * `orientation` of `image`, if orientation could not be
+		 * determined). The copy holds its pixels in `pixels` if
+		 * `image` does, and otherwise views the same pixels.
+		 * Implementations that compute foreground masks or finger
+		 * blobs for both operations should override this method to
+		 * compute them once.
+		 *
+		 * @note
+		 * This method shall return on average within the sum of the
+		 * time limits for Interface::segment() and
+		 * Interface::determineOrientation().
+		 */
+		virtual
+		std::tuple<std::tuple<ReturnStatus,
+		    std::vector<SegmentationPosition>>,
+		    std::tuple<ReturnStatus, SlapImage::Orientation>>
+		segmentAndDetermineOrientation(
+		    const SlapImage &image);
+
+		/**
+		 * @brief
+		 * Begin segmenting an image whose rows will be delivered
+		 * incrementally.
+		 *
+		 * @param metadata
+		 * Metadata of the image to segment. Image data is ignored.
+		 *
+		 * @return
+		 * Stream to which rows of the image are pushed.
+		 *
+		 * @note
+		 * The default implementation returns a stream that copies
+		 * rows into a buffer, then calls
+		 * Interface::segment(const SlapImage&) from finish().
+		 */
+		virtual
+		std::unique_ptr<SegmentationStream>
+		beginSegmentation(
+		    const SlapImage &metadata);
+
+		/**
+		 * @brief
+		 * Discover fingerprint segmentation positions, starting from
+		 * positions found in a similar image.
+		 *
+		 * @param image
+		 * Image data and metadata to segment.
+		 * @param hint
+		 * Segmentation positions of a previous frame of the same
+		 * slap. May be empty.
+		 *
+		 * @return
+		 * See Interface::segment(const SlapImage&).
+		 *
+		 * @note
+		 * Positions in `image` are expected to be near those in
+		 * `hint`, but implementations must not assume they are equal.
+		 * The default implementation ignores `hint` and calls
+		 * Interface::segment(const SlapImage&).
+		 */
+		virtual
+		std::tuple<ReturnStatus, std::vector<SegmentationPosition>>
+		segmentWithHint(
+		    const SlapImage &image,
+		    const std::span<const SegmentationPosition> hint);
+
+		/**
+		 * @brief
+		 * Begin segmenting consecutive frames of the same slap.
+		 *
+		 * @return
+		 * Session to which frames are passed.
+		 *
+		 * @note
+		 * The default implementation returns a session that passes
+		 * the positions of the previous frame, if segmenting it was
+		 * successful, to Interface::segmentWithHint().
+		 */
+		virtual
+		std::unique_ptr<SegmentationSession>
+		beginSession();
+
 		/** Destructor. */
 		virtual ~Interface();
 
@@ -594,6 +1976,109 @@ namespace SlapSegIII
 		    const std::filesystem::path &configurationDirectory);
 	};
 
+	/**
+	 * @brief
+	 * Asynchronous submission of SlapSegIII::Interface operations.
+	 *
+	 * @details
+	 * Submitted operations are queued and run on an internal pool of
+	 * threads that call the synchronous methods of a
+	 * SlapSegIII::Interface. Results (or exceptions thrown by the
+	 * Interface) are delivered through std::future, allowing callers to
+	 * keep several operations in flight without blocking one thread per
+	 * operation.
+	 *
+	 * @note
+	 * Participants are not required to subclass this class. Those with
+	 * a native asynchronous implementation may override its methods.
+	 */
+	class AsyncInterface
+	{
+	public:
+		/**
+		 * @brief
+		 * AsyncInterface constructor.
+		 *
+		 * @param implementation
+		 * Implementation whose synchronous methods will be called.
+		 * @param numThreads
+		 * Number of threads calling into `implementation`. Values
+		 * greater than 1 require `implementation` to be reentrant.
+		 *
+		 * @throw std::system_error
+		 * A thread could not be started. Threads already started
+		 * are joined first.
+		 */
+		AsyncInterface(
+		    std::shared_ptr<Interface> implementation,
+		    const uint16_t numThreads = 1);
+
+		/**
+		 * @brief
+		 * Queue a call to Interface::segment().
+		 *
+		 * @param image
+		 * Image data and metadata to segment. Kept alive until the
+		 * operation completes.
+		 *
+		 * @return
+		 * Future that will hold the value returned from
+		 * Interface::segment().
+		 */
+		virtual
+		std::future<std::tuple<ReturnStatus,
+		    std::vector<SegmentationPosition>>>
+		segment(
+		    std::shared_ptr<const SlapImage> image);
+
+		/**
+		 * @brief
+		 * Queue a call to Interface::determineOrientation().
+		 *
+		 * @param image
+		 * Image data and metadata. Kept alive until the operation
+		 * completes.
+		 *
+		 * @return
+		 * Future that will hold the value returned from
+		 * Interface::determineOrientation().
+		 */
+		virtual
+		std::future<std::tuple<ReturnStatus, SlapImage::Orientation>>
+		determineOrientation(
+		    std::shared_ptr<const SlapImage> image);
+
+		/** Destructor. Waits for queued operations to complete. */
+		virtual ~AsyncInterface();
+
+		AsyncInterface(const AsyncInterface&) = delete;
+		AsyncInterface& operator=(const AsyncInterface&) = delete;
+
+	protected:
+		/**
+		 * @brief
+		 * Queue an operation to run on the threads servicing
+		 * submitted operations.
+		 *
+		 * @param operation
+		 * Operation to run. Exceptions shall not escape it; those
+		 * meant for the caller should be stored in a std::promise
+		 * or std::packaged_task.
+		 */
+		void
+		enqueue(
+		    std::function<void()> &&operation);
+
+		/** Implementation whose synchronous methods are called. */
+		const std::shared_ptr<Interface> implementation{};
+
+	private:
+		/** Thread pool type, defined in libslapsegiii. */
+		struct Pool;
+		/** Threads and queue servicing submitted operations. */
+		std::unique_ptr<Pool> pool;
+	};
+
 	/*
 	 * API versioning.
 	 *
@@ -611,7 +2096,7 @@ namespace SlapSegIII
 	/** API major version number. */
 	uint16_t API_MAJOR_VERSION{1};
 	/** API minor version number. */
-	uint16_t API_MINOR_VERSION{2};
+	uint16_t API_MINOR_VERSION{3};
 	/** API patch version number. */
 	uint16_t API_PATCH_VERSION{0};
 	#endif /* NIST_EXTERN_API_VERSION */
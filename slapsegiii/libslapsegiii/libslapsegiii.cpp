@@ -8,8 +8,104 @@
  * about its quality, reliability, or any other characteristic.
  */
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include <slapsegiii.h>
 
+struct SlapSegIII::SlapImage::Pyramid
+{
+	/** Protects levels */
+	std::mutex mutex{};
+	/** Pixels of levels 1, 2, ... built so far */
+	std::vector<std::shared_ptr<const std::vector<std::byte>>> levels{};
+};
+
+namespace SlapSegIII
+{
+	/**
+	 * @brief
+	 * Halve the resolution of an image by averaging 2x2 blocks.
+	 *
+	 * @param pixels
+	 * 8 bits/pixel image data, starting with the top-left pixel.
+	 * @param width
+	 * Width of the image.
+	 * @param height
+	 * Height of the image.
+	 * @param stride
+	 * Number of bytes between the starts of consecutive rows.
+	 *
+	 * @return
+	 * (`width` / 2) * (`height` / 2) bytes of image data. An odd last
+	 * row or column is dropped.
+	 */
+	static std::vector<std::byte>
+	downsample(
+	    const std::span<const std::byte> pixels,
+	    const std::size_t width,
+	    const std::size_t height,
+	    const std::size_t stride);
+}
+
+std::vector<std::byte>
+SlapSegIII::downsample(
+    const std::span<const std::byte> pixels,
+    const std::size_t width,
+    const std::size_t height,
+    const std::size_t stride)
+{
+	const std::size_t outWidth{width / 2};
+	const std::size_t outHeight{height / 2};
+	std::vector<std::byte> out(outWidth * outHeight);
+
+	const auto in = reinterpret_cast<const uint8_t*>(pixels.data());
+	auto dst = reinterpret_cast<uint8_t*>(out.data());
+	for (std::size_t y{0}; y < outHeight; ++y) {
+		const uint8_t *top{in + (2 * y * stride)};
+		const uint8_t *bottom{top + stride};
+		uint8_t *row{dst + (y * outWidth)};
+
+		std::size_t x{0};
+#if defined(__SSE2__)
+		/* 16 output pixels from 32 columns of two rows at a time */
+		const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+		const __m128i two = _mm_set1_epi16(2);
+		const auto sumPairs = [&](const uint8_t *p) -> __m128i {
+			const __m128i v = _mm_loadu_si128(
+			    reinterpret_cast<const __m128i*>(p));
+			return (_mm_add_epi16(_mm_and_si128(v, lowBytes),
+			    _mm_srli_epi16(v, 8)));
+		};
+		for (; x + 16 <= outWidth; x += 16) {
+			const __m128i left = _mm_srli_epi16(_mm_add_epi16(
+			    _mm_add_epi16(sumPairs(top + (2 * x)),
+			    sumPairs(bottom + (2 * x))), two), 2);
+			const __m128i right = _mm_srli_epi16(_mm_add_epi16(
+			    _mm_add_epi16(sumPairs(top + (2 * x) + 16),
+			    sumPairs(bottom + (2 * x) + 16)), two), 2);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(row + x),
+			    _mm_packus_epi16(left, right));
+		}
+#endif
+		/* Remaining pixels (all pixels without SSE2) */
+		for (; x < outWidth; ++x)
+			row[x] = static_cast<uint8_t>((top[2 * x] +
+			    top[(2 * x) + 1] + bottom[2 * x] +
+			    bottom[(2 * x) + 1] + 2) / 4);
+	}
+
+	return (out);
+}
+
 SlapSegIII::Coordinate::Coordinate(
     const int32_t x,
     const int32_t y)
@@ -22,9 +118,9 @@ SlapSegIII::Coordinate::Coordinate(
 
 SlapSegIII::SegmentationPosition::Result::Result(
     const Code code,
-    const std::string &message) :
+    std::string message) :
     code{code},
-    message{message}
+    message{std::move(message)}
 {
 
 }
@@ -40,13 +136,13 @@ SlapSegIII::SegmentationPosition::SegmentationPosition(
     const Coordinate &tr,
     const Coordinate &bl,
     const Coordinate &br,
-    const Result result) :
+    Result result) :
     frgp{frgp},
     tl{tl},
     tr{tr},
     bl{bl},
     br{br},
-    result{result}
+    result{std::move(result)}
 {
 
 }
@@ -75,6 +171,262 @@ SlapSegIII::SlapImage::SlapImage(
 
 }
 
+SlapSegIII::SlapImage::SlapImage(
+    const uint16_t width,
+    const uint16_t height,
+    const uint16_t ppi,
+    const Kind kind,
+    const CaptureTechnology captureTechnology,
+    const Orientation orientation,
+    std::vector<std::byte> &&pixels) :
+    width{width},
+    height{height},
+    ppi{ppi},
+    kind{kind},
+    captureTechnology{captureTechnology},
+    orientation{orientation},
+    pixels{std::move(pixels)}
+{
+
+}
+
+SlapSegIII::SlapImage::SlapImage(
+    const uint16_t width,
+    const uint16_t height,
+    const uint16_t ppi,
+    const Kind kind,
+    const CaptureTechnology captureTechnology,
+    const Orientation orientation,
+    const std::span<const std::byte> pixelView,
+    std::shared_ptr<const void> pixelOwner) :
+    width{width},
+    height{height},
+    ppi{ppi},
+    kind{kind},
+    captureTechnology{captureTechnology},
+    orientation{orientation},
+    pixelView{pixelView},
+    pixelOwner{std::move(pixelOwner)}
+{
+
+}
+
+std::span<const std::byte>
+SlapSegIII::SlapImage::getPixels()
+    const
+    noexcept
+{
+	if (this->pixelView.data() != nullptr)
+		return (this->pixelView);
+	return (this->pixels);
+}
+
+std::size_t
+SlapSegIII::SlapImage::getRowStride()
+    const
+    noexcept
+{
+	return (this->rowStride == 0 ? this->width : this->rowStride);
+}
+
+std::span<const std::byte>
+SlapSegIII::SlapImage::getRow(
+    const uint16_t row)
+    const
+    noexcept
+{
+	return (this->getPixels().subspan(((static_cast<std::size_t>(
+	    this->yOffset) + row) * this->getRowStride()) + this->xOffset,
+	    this->width));
+}
+
+bool
+SlapSegIII::SlapImage::isPacked()
+    const
+    noexcept
+{
+	return ((this->getRowStride() == this->width) &&
+	    (this->xOffset == 0) && (this->yOffset == 0) &&
+	    (this->getPixels().size() ==
+	    static_cast<std::size_t>(this->width) * this->height));
+}
+
+bool
+SlapSegIII::SlapImage::hasValidLayout()
+    const
+    noexcept
+{
+	const auto stride = this->getRowStride();
+	if ((static_cast<std::size_t>(this->xOffset) + this->width) > stride)
+		return (false);
+	if ((this->width == 0) || (this->height == 0))
+		return (true);
+
+	/* Last byte of the last row must be within the buffer */
+	const std::size_t end{((static_cast<std::size_t>(this->yOffset) +
+	    this->height - 1) * stride) + this->xOffset + this->width};
+	return (end <= this->getPixels().size());
+}
+
+std::vector<std::byte>
+SlapSegIII::SlapImage::getPackedPixels()
+    const
+{
+	if (!this->hasValidLayout())
+		throw std::invalid_argument{"Image data is smaller than its "
+		    "layout requires"};
+
+	std::vector<std::byte> packed{};
+	packed.reserve(static_cast<std::size_t>(this->width) * this->height);
+	for (uint16_t row{0}; row < this->height; ++row) {
+		const auto r = this->getRow(row);
+		packed.insert(packed.end(), r.begin(), r.end());
+	}
+
+	return (packed);
+}
+
+SlapSegIII::SlapImage::LazyPyramid::LazyPyramid()
+    noexcept
+{
+
+}
+
+SlapSegIII::SlapImage::LazyPyramid::LazyPyramid(
+    const LazyPyramid &other)
+    noexcept :
+    pyramid{other.pyramid.load()}
+{
+
+}
+
+SlapSegIII::SlapImage::LazyPyramid&
+SlapSegIII::SlapImage::LazyPyramid::operator=(
+    const LazyPyramid &other)
+    noexcept
+{
+	if (this != &other)
+		this->pyramid.store(other.pyramid.load());
+
+	return (*this);
+}
+
+std::shared_ptr<SlapSegIII::SlapImage::Pyramid>
+SlapSegIII::SlapImage::LazyPyramid::get()
+    const
+{
+	auto current = this->pyramid.load();
+	if (current != nullptr)
+		return (current);
+
+	/* If another thread got here first, use the Pyramid it created */
+	auto created = std::make_shared<Pyramid>();
+	if (this->pyramid.compare_exchange_strong(current, created))
+		return (created);
+	return (current);
+}
+
+SlapSegIII::SlapImage
+SlapSegIII::SlapImage::getPyramidLevel(
+    const uint8_t level)
+    const
+{
+	if (!this->hasValidLayout())
+		throw std::invalid_argument{"Image data is smaller than its "
+		    "layout requires"};
+	if (level == 0)
+		return (*this);
+	if (((this->width >> level) == 0) || ((this->height >> level) == 0))
+		throw std::invalid_argument{"Pyramid level " +
+		    std::to_string(level) + " would be empty"};
+
+	const auto pyramid = this->pyramid.get();
+	std::shared_ptr<const std::vector<std::byte>> levelData{};
+	{
+		std::lock_guard<std::mutex> lock{pyramid->mutex};
+		auto &levels = pyramid->levels;
+		while (levels.size() < level) {
+			const auto depth = levels.size();
+			/* Level 1 reads the region of interest in place */
+			const std::size_t levelWidth{
+			    static_cast<std::size_t>(this->width >> depth)};
+			levels.push_back(std::make_shared<
+			    const std::vector<std::byte>>(downsample(
+			    depth == 0 ? this->getPixels().subspan(
+			    (this->yOffset * this->getRowStride()) +
+			    this->xOffset) :
+			    std::span<const std::byte>{*levels.back()},
+			    levelWidth,
+			    static_cast<std::size_t>(this->height >> depth),
+			    depth == 0 ? this->getRowStride() : levelWidth)));
+		}
+		levelData = levels[level - 1u];
+	}
+
+	SlapImage reduced{static_cast<uint16_t>(this->width >> level),
+	    static_cast<uint16_t>(this->height >> level),
+	    static_cast<uint16_t>(this->ppi >> level), this->kind,
+	    this->captureTechnology, this->orientation, *levelData, levelData};
+	return (reduced);
+}
+
+SlapSegIII::ConcurrencyCapabilities::ConcurrencyCapabilities(
+    const bool reentrant,
+    const uint16_t maxConcurrentCalls,
+    const uint16_t threadsPerCall)
+    noexcept :
+    reentrant{reentrant},
+    maxConcurrentCalls{maxConcurrentCalls},
+    threadsPerCall{threadsPerCall}
+{
+
+}
+
+SlapSegIII::ResourceRequirements::ResourceRequirements(
+    const uint64_t peakScratchBytes,
+    const uint64_t workingSetBytes)
+    noexcept :
+    peakScratchBytes{peakScratchBytes},
+    workingSetBytes{workingSetBytes}
+{
+
+}
+
+SlapSegIII::CancellationToken::CancellationToken(
+    const Clock::time_point deadline) :
+    deadline{deadline},
+    cancelled{std::make_shared<std::atomic<bool>>(false)}
+{
+
+}
+
+void
+SlapSegIII::CancellationToken::cancel()
+    noexcept
+{
+	this->cancelled->store(true);
+}
+
+bool
+SlapSegIII::CancellationToken::isCancelled()
+    const
+    noexcept
+{
+	if (this->cancelled->load())
+		return (true);
+	if (this->deadline == Clock::time_point::max())
+		return (false);
+	return (Clock::now() >= this->deadline);
+}
+
+SlapSegIII::CancellationToken::Clock::time_point
+SlapSegIII::CancellationToken::getDeadline()
+    const
+    noexcept
+{
+	return (this->deadline);
+}
+
 SlapSegIII::SubmissionIdentification::SubmissionIdentification()
 {
 
@@ -93,8 +445,285 @@ SlapSegIII::SubmissionIdentification::SubmissionIdentification(
 
 SlapSegIII::ReturnStatus::ReturnStatus(
     const Code code,
-    const std::set<SlapImage::Deficiency> &imageDeficiencies,
-    const std::string &message) :
+    std::set<SlapImage::Deficiency> imageDeficiencies,
+    std::string message) :
+    code{code},
+    imageDeficiencies{std::move(imageDeficiencies)},
+    message{std::move(message)}
+{
+
+}
+
+std::string_view
+SlapSegIII::internMessage(
+    const std::string_view message)
+{
+	/* Fixed storage, so distinct messages cannot grow memory use */
+	static constexpr std::size_t Capacity{256};
+	static std::mutex mutex{};
+	static std::array<std::array<char,
+	    CompactSegmentationPositions::MessageCapacity>, Capacity>
+	    storage{};
+	static std::set<std::string_view> messages{};
+
+	const auto truncated = message.substr(0,
+	    CompactSegmentationPositions::MessageCapacity);
+
+	std::lock_guard<std::mutex> lock{mutex};
+	const auto it = messages.find(truncated);
+	if (it != messages.end())
+		return (*it);
+	if (messages.size() == Capacity)
+		return {};
+
+	auto &copy = storage[messages.size()];
+	const auto length = truncated.copy(copy.data(), copy.size());
+	return (*messages.emplace(copy.data(), length).first);
+}
+
+SlapSegIII::DeficiencyMask::DeficiencyMask()
+    noexcept
+{
+
+}
+
+SlapSegIII::DeficiencyMask::DeficiencyMask(
+    const std::set<SlapImage::Deficiency> &deficiencies)
+    noexcept
+{
+	for (const auto &deficiency : deficiencies)
+		this->set(deficiency);
+}
+
+void
+SlapSegIII::DeficiencyMask::set(
+    const SlapImage::Deficiency deficiency)
+    noexcept
+{
+	this->bits = static_cast<uint8_t>(this->bits |
+	    (1u << static_cast<unsigned int>(deficiency)));
+}
+
+void
+SlapSegIII::DeficiencyMask::reset(
+    const SlapImage::Deficiency deficiency)
+    noexcept
+{
+	this->bits = static_cast<uint8_t>(this->bits &
+	    ~(1u << static_cast<unsigned int>(deficiency)));
+}
+
+bool
+SlapSegIII::DeficiencyMask::test(
+    const SlapImage::Deficiency deficiency)
+    const
+    noexcept
+{
+	return ((this->bits &
+	    (1u << static_cast<unsigned int>(deficiency))) != 0);
+}
+
+bool
+SlapSegIII::DeficiencyMask::none()
+    const
+    noexcept
+{
+	return (this->bits == 0);
+}
+
+std::set<SlapSegIII::SlapImage::Deficiency>
+SlapSegIII::DeficiencyMask::toSet()
+    const
+{
+	std::set<SlapImage::Deficiency> deficiencies{};
+	for (const auto deficiency : {SlapImage::Deficiency::Artifacts,
+	    SlapImage::Deficiency::ImageQuality,
+	    SlapImage::Deficiency::HandGeometry,
+	    SlapImage::Deficiency::Incomplete})
+		if (this->test(deficiency))
+			deficiencies.insert(deficiency);
+
+	return (deficiencies);
+}
+
+SlapSegIII::CompactSegmentationPosition::CompactSegmentationPosition()
+    noexcept
+{
+
+}
+
+SlapSegIII::CompactSegmentationPosition::CompactSegmentationPosition(
+    const FrictionRidgeGeneralizedPosition frgp,
+    const Coordinate &tl,
+    const Coordinate &tr,
+    const Coordinate &bl,
+    const Coordinate &br,
+    const SegmentationPosition::Result::Code code,
+    const std::string_view message)
+    noexcept :
+    frgp{frgp},
+    tl{tl},
+    tr{tr},
+    bl{bl},
+    br{br},
+    code{code},
+    message{message}
+{
+
+}
+
+SlapSegIII::CompactSegmentationPosition::CompactSegmentationPosition(
+    const SegmentationPosition &position) :
+    frgp{position.frgp},
+    tl{position.tl},
+    tr{position.tr},
+    bl{position.bl},
+    br{position.br},
+    code{position.result.code},
+    message{position.result.message.empty() ? std::string_view{} :
+        internMessage(position.result.message)}
+{
+
+}
+
+SlapSegIII::SegmentationPosition
+SlapSegIII::CompactSegmentationPosition::toSegmentationPosition()
+    const
+{
+	return {this->frgp, this->tl, this->tr, this->bl, this->br,
+	    {this->code, std::string{this->message}}};
+}
+
+SlapSegIII::CompactSegmentationPositions::CompactSegmentationPositions()
+    noexcept
+{
+
+}
+
+void
+SlapSegIII::CompactSegmentationPositions::push_back(
+    const CompactSegmentationPosition &position)
+{
+	if (this->count == Capacity)
+		throw std::length_error{"CompactSegmentationPositions is full"};
+
+	this->positions[this->count++] = position;
+}
+
+SlapSegIII::CompactSegmentationPositions::CompactSegmentationPositions(
+    const CompactSegmentationPositions &other)
+    noexcept
+{
+	*this = other;
+}
+
+SlapSegIII::CompactSegmentationPositions&
+SlapSegIII::CompactSegmentationPositions::operator=(
+    const CompactSegmentationPositions &other)
+    noexcept
+{
+	if (this == &other)
+		return (*this);
+
+	this->positions = other.positions;
+	this->count = other.count;
+	this->messages = other.messages;
+	this->messageCount = other.messageCount;
+
+	/* Copied messages must view our storage, not other's */
+	const auto *first = other.messages.front().data();
+	const auto *last = first + sizeof(other.messages);
+	for (std::size_t i{0}; i < this->count; ++i) {
+		auto &message = this->positions[i].message;
+		if ((message.data() < first) || (message.data() >= last))
+			continue;
+		message = {this->messages.front().data() +
+		    (message.data() - first), message.size()};
+	}
+
+	return (*this);
+}
+
+void
+SlapSegIII::CompactSegmentationPositions::clear()
+    noexcept
+{
+	this->count = 0;
+	this->messageCount = 0;
+}
+
+std::string_view
+SlapSegIII::CompactSegmentationPositions::copyMessage(
+    const std::string_view message)
+    noexcept
+{
+	if (message.empty() || (this->messageCount == this->messages.size()))
+		return {};
+
+	auto &storage = this->messages[this->messageCount++];
+	const auto length = message.copy(storage.data(), storage.size());
+
+	return {storage.data(), length};
+}
+
+std::size_t
+SlapSegIII::CompactSegmentationPositions::size()
+    const
+    noexcept
+{
+	return (this->count);
+}
+
+bool
+SlapSegIII::CompactSegmentationPositions::empty()
+    const
+    noexcept
+{
+	return (this->count == 0);
+}
+
+const SlapSegIII::CompactSegmentationPosition*
+SlapSegIII::CompactSegmentationPositions::begin()
+    const
+    noexcept
+{
+	return (this->positions.data());
+}
+
+const SlapSegIII::CompactSegmentationPosition*
+SlapSegIII::CompactSegmentationPositions::end()
+    const
+    noexcept
+{
+	return (this->positions.data() + this->count);
+}
+
+const SlapSegIII::CompactSegmentationPosition&
+SlapSegIII::CompactSegmentationPositions::operator[](
+    const std::size_t index)
+    const
+    noexcept
+{
+	return (this->positions[index]);
+}
+
+std::vector<SlapSegIII::SegmentationPosition>
+SlapSegIII::CompactSegmentationPositions::toSegmentationPositions()
+    const
+{
+	std::vector<SegmentationPosition> converted{};
+	converted.reserve(this->count);
+	for (const auto &position : *this)
+		converted.push_back(position.toSegmentationPosition());
+
+	return (converted);
+}
+
+SlapSegIII::CompactReturnStatus::CompactReturnStatus(
+    const ReturnStatus::Code code,
+    const DeficiencyMask imageDeficiencies,
+    const std::string_view message)
+    noexcept :
     code{code},
     imageDeficiencies{imageDeficiencies},
     message{message}
@@ -102,7 +731,451 @@ SlapSegIII::ReturnStatus::ReturnStatus(
 
 }
 
+SlapSegIII::CompactReturnStatus::CompactReturnStatus(
+    const ReturnStatus &status) :
+    code{status.code},
+    imageDeficiencies{status.imageDeficiencies},
+    message{status.message.empty() ? std::string_view{} :
+        internMessage(status.message)}
+{
+
+}
+
+SlapSegIII::ReturnStatus
+SlapSegIII::CompactReturnStatus::toReturnStatus()
+    const
+{
+	return {this->code, this->imageDeficiencies.toSet(),
+	    std::string{this->message}};
+}
+
+bool
+SlapSegIII::Interface::supportsPixelViews()
+    const
+{
+	return (false);
+}
+
+SlapSegIII::ReturnStatus
+SlapSegIII::Interface::prepare(
+    const std::set<SlapImage::Kind>&)
+{
+	return {};
+}
+
+void
+SlapSegIII::Interface::preFork()
+{
+
+}
+
+void
+SlapSegIII::Interface::postForkParent()
+{
+
+}
+
+void
+SlapSegIII::Interface::postForkChild()
+{
+
+}
+
+SlapSegIII::ConcurrencyCapabilities
+SlapSegIII::Interface::getConcurrencyCapabilities()
+    const
+{
+	return {};
+}
+
+SlapSegIII::ResourceRequirements
+SlapSegIII::Interface::getResourceRequirements(
+    const SlapImage::Kind,
+    const uint16_t)
+    const
+{
+	return {};
+}
+
+void
+SlapSegIII::Interface::setMemoryResource(
+    std::pmr::memory_resource*)
+{
+
+}
+
+std::tuple<SlapSegIII::ReturnStatus,
+    std::vector<SlapSegIII::SegmentationPosition>>
+SlapSegIII::Interface::segmentWithCancellation(
+    const SlapImage &image,
+    const CancellationToken &cancellation)
+{
+	if (cancellation.isCancelled())
+		return (std::make_tuple(ReturnStatus::Code::TimedOut,
+		    std::vector<SegmentationPosition>{}));
+
+	return (this->segment(image));
+}
+
+SlapSegIII::CompactReturnStatus
+SlapSegIII::Interface::segmentInto(
+    const SlapImage &image,
+    CompactSegmentationPositions &positions)
+{
+	positions.clear();
+
+	/* Copy rather than intern messages, which may be unique per call */
+	const auto [status, legacyPositions] = this->segment(image);
+	for (const auto &position : legacyPositions) {
+		if (positions.size() == CompactSegmentationPositions::Capacity)
+			return {ReturnStatus::Code::VendorDefined,
+			    status.imageDeficiencies, "segment() returned more "
+			    "positions than CompactSegmentationPositions "
+			    "can hold"};
+
+		positions.push_back({position.frgp, position.tl, position.tr,
+		    position.bl, position.br, position.result.code,
+		    positions.copyMessage(position.result.message)});
+	}
+
+	return {status.code, status.imageDeficiencies,
+	    positions.copyMessage(status.message)};
+}
+
+std::tuple<SlapSegIII::ReturnStatus, SlapSegIII::SlapImage::Orientation>
+SlapSegIII::Interface::determineOrientationWithCancellation(
+    const SlapImage &image,
+    const CancellationToken &cancellation)
+{
+	if (cancellation.isCancelled())
+		return (std::make_tuple(ReturnStatus::Code::TimedOut,
+		    SlapImage::Orientation{}));
+
+	return (this->determineOrientation(image));
+}
+
+std::vector<std::tuple<SlapSegIII::ReturnStatus,
+    std::vector<SlapSegIII::SegmentationPosition>>>
+SlapSegIII::Interface::segmentBatch(
+    const std::span<const SlapImage> images)
+{
+	std::vector<std::tuple<ReturnStatus,
+	    std::vector<SegmentationPosition>>> results{};
+	results.reserve(images.size());
+	for (const auto &image : images)
+		results.push_back(this->segment(image));
+
+	return (results);
+}
+
+std::tuple<std::tuple<SlapSegIII::ReturnStatus,
+    std::vector<SlapSegIII::SegmentationPosition>>,
+    std::tuple<SlapSegIII::ReturnStatus, SlapSegIII::SlapImage::Orientation>>
+SlapSegIII::Interface::segmentAndDetermineOrientation(
+    const SlapImage &image)
+{
+	const auto orientation = this->determineOrientation(image);
+
+	/*
+	 * Same pixels, with the hypothesized orientation. Owning images
+	 * stay owning, as segment() may read only `pixels`.
+	 */
+	const auto hypothesized = std::get<0>(orientation).code ==
+	    ReturnStatus::Code::Success ? std::get<1>(orientation) :
+	    image.orientation;
+	SlapImage oriented = (image.pixelView.data() == nullptr) ?
+	    SlapImage{image.width, image.height, image.ppi, image.kind,
+	    image.captureTechnology, hypothesized, image.pixels} :
+	    SlapImage{image.width, image.height, image.ppi, image.kind,
+	    image.captureTechnology, hypothesized, image.pixelView,
+	    image.pixelOwner};
+	oriented.rowStride = image.rowStride;
+	oriented.xOffset = image.xOffset;
+	oriented.yOffset = image.yOffset;
+	/* Share lower-resolution levels built while orienting */
+	oriented.pyramid = image.pyramid;
+
+	return (std::make_tuple(this->segment(oriented), orientation));
+}
+
+namespace SlapSegIII
+{
+	/** Stream that buffers rows until the whole image is available. */
+	class BufferedSegmentationStream : public SegmentationStream
+	{
+	public:
+		BufferedSegmentationStream(
+		    Interface &implementation,
+		    const SlapImage &metadata);
+
+		ReturnStatus
+		pushRows(
+		    const std::span<const std::byte> rows)
+		    override;
+
+		std::tuple<ReturnStatus, std::vector<SegmentationPosition>>
+		finish()
+		    override;
+
+	private:
+		/** Implementation whose segment() is called from finish() */
+		Interface &implementation;
+		/** Metadata, and rows pushed so far */
+		SlapImage image{};
+		/** Number of bytes in the complete image */
+		std::size_t size{};
+	};
+}
+
+SlapSegIII::BufferedSegmentationStream::BufferedSegmentationStream(
+    Interface &implementation,
+    const SlapImage &metadata) :
+    implementation{implementation},
+    image{metadata.width, metadata.height, metadata.ppi, metadata.kind,
+        metadata.captureTechnology, metadata.orientation,
+        std::vector<std::byte>{}},
+    size{static_cast<std::size_t>(metadata.width) * metadata.height}
+{
+	this->image.pixels.reserve(this->size);
+}
+
+SlapSegIII::ReturnStatus
+SlapSegIII::BufferedSegmentationStream::pushRows(
+    const std::span<const std::byte> rows)
+{
+	if ((this->image.width == 0) || ((rows.size() % this->image.width) !=
+	    0))
+		throw std::invalid_argument{"Rows must be a multiple of "
+		    "width bytes"};
+	if ((this->image.pixels.size() + rows.size()) > this->size)
+		throw std::invalid_argument{"Rows extend past the last row "
+		    "of the image"};
+
+	this->image.pixels.insert(this->image.pixels.end(), rows.begin(),
+	    rows.end());
+	return {};
+}
+
+std::tuple<SlapSegIII::ReturnStatus,
+    std::vector<SlapSegIII::SegmentationPosition>>
+SlapSegIII::BufferedSegmentationStream::finish()
+{
+	if (this->image.pixels.size() != this->size)
+		throw std::logic_error{"finish() called before all rows were "
+		    "pushed"};
+
+	return (this->implementation.segment(this->image));
+}
+
+SlapSegIII::SegmentationStream::~SegmentationStream()
+{
+
+}
+
+std::unique_ptr<SlapSegIII::SegmentationStream>
+SlapSegIII::Interface::beginSegmentation(
+    const SlapImage &metadata)
+{
+	return (std::make_unique<BufferedSegmentationStream>(*this,
+	    metadata));
+}
+
+namespace SlapSegIII
+{
+	/** Session hinting each frame with the previous frame's result. */
+	class HintingSegmentationSession : public SegmentationSession
+	{
+	public:
+		HintingSegmentationSession(
+		    Interface &implementation);
+
+		std::tuple<ReturnStatus, std::vector<SegmentationPosition>>
+		segmentFrame(
+		    const SlapImage &frame)
+		    override;
+
+		void
+		reset()
+		    override;
+
+	private:
+		/** Implementation whose segmentWithHint() is called */
+		Interface &implementation;
+		/** Positions of the last successfully segmented frame */
+		std::vector<SegmentationPosition> previous{};
+	};
+}
+
+SlapSegIII::HintingSegmentationSession::HintingSegmentationSession(
+    Interface &implementation) :
+    implementation{implementation}
+{
+
+}
+
+std::tuple<SlapSegIII::ReturnStatus,
+    std::vector<SlapSegIII::SegmentationPosition>>
+SlapSegIII::HintingSegmentationSession::segmentFrame(
+    const SlapImage &frame)
+{
+	auto rv = this->implementation.segmentWithHint(frame,
+	    this->previous);
+
+	if (std::get<0>(rv).code == ReturnStatus::Code::Success)
+		this->previous = std::get<1>(rv);
+	else
+		this->previous.clear();
+
+	return (rv);
+}
+
+void
+SlapSegIII::HintingSegmentationSession::reset()
+{
+	this->previous.clear();
+}
+
+SlapSegIII::SegmentationSession::~SegmentationSession()
+{
+
+}
+
+std::tuple<SlapSegIII::ReturnStatus,
+    std::vector<SlapSegIII::SegmentationPosition>>
+SlapSegIII::Interface::segmentWithHint(
+    const SlapImage &image,
+    const std::span<const SegmentationPosition>)
+{
+	return (this->segment(image));
+}
+
+std::unique_ptr<SlapSegIII::SegmentationSession>
+SlapSegIII::Interface::beginSession()
+{
+	return (std::make_unique<HintingSegmentationSession>(*this));
+}
+
 SlapSegIII::Interface::~Interface()
 {
 
 }
+
+struct SlapSegIII::AsyncInterface::Pool
+{
+	/** Add an operation to the queue. */
+	void
+	enqueue(
+	    std::function<void()> &&operation)
+	{
+		{
+			std::lock_guard<std::mutex> lock{this->mutex};
+			this->operations.push_back(std::move(operation));
+		}
+		this->available.notify_one();
+	}
+
+	/** Run queued operations until stopped and the queue is empty. */
+	void
+	work()
+	{
+		for (;;) {
+			std::function<void()> operation{};
+			{
+				std::unique_lock<std::mutex> lock{this->mutex};
+				this->available.wait(lock, [this]() -> bool {
+					return (this->stopping ||
+					    !this->operations.empty());
+				});
+				if (this->operations.empty())
+					return;
+
+				operation = std::move(
+				    this->operations.front());
+				this->operations.pop_front();
+			}
+			operation();
+		}
+	}
+
+	/** Finish queued operations and join every started thread. */
+	void
+	stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock{this->mutex};
+			this->stopping = true;
+		}
+		this->available.notify_all();
+		for (auto &thread : this->threads)
+			thread.join();
+	}
+
+	std::mutex mutex{};
+	std::condition_variable available{};
+	std::deque<std::function<void()>> operations{};
+	bool stopping{false};
+	std::vector<std::thread> threads{};
+};
+
+SlapSegIII::AsyncInterface::AsyncInterface(
+    std::shared_ptr<Interface> implementation,
+    const uint16_t numThreads) :
+    implementation{std::move(implementation)},
+    pool{std::make_unique<Pool>()}
+{
+	const uint16_t count{numThreads == 0 ? uint16_t{1} : numThreads};
+	this->pool->threads.reserve(count);
+	try {
+		for (uint16_t i{0}; i < count; ++i)
+			this->pool->threads.emplace_back(&Pool::work,
+			    this->pool.get());
+	} catch (...) {
+		/* Joinable threads would call std::terminate() */
+		this->pool->stop();
+		throw;
+	}
+}
+
+std::future<std::tuple<SlapSegIII::ReturnStatus,
+    std::vector<SlapSegIII::SegmentationPosition>>>
+SlapSegIII::AsyncInterface::segment(
+    std::shared_ptr<const SlapImage> image)
+{
+	auto task = std::make_shared<std::packaged_task<std::tuple<
+	    ReturnStatus, std::vector<SegmentationPosition>>()>>(
+	    [impl = this->implementation, image = std::move(image)]() {
+		return (impl->segment(*image));
+	    });
+	auto future = task->get_future();
+	this->enqueue([task]() { (*task)(); });
+
+	return (future);
+}
+
+std::future<std::tuple<SlapSegIII::ReturnStatus,
+    SlapSegIII::SlapImage::Orientation>>
+SlapSegIII::AsyncInterface::determineOrientation(
+    std::shared_ptr<const SlapImage> image)
+{
+	auto task = std::make_shared<std::packaged_task<std::tuple<
+	    ReturnStatus, SlapImage::Orientation>()>>(
+	    [impl = this->implementation, image = std::move(image)]() {
+		return (impl->determineOrientation(*image));
+	    });
+	auto future = task->get_future();
+	this->enqueue([task]() { (*task)(); });
+
+	return (future);
+}
+
+void
+SlapSegIII::AsyncInterface::enqueue(
+    std::function<void()> &&operation)
+{
+	this->pool->enqueue(std::move(operation));
+}
+
+SlapSegIII::AsyncInterface::~AsyncInterface()
+{
+	this->pool->stop();
+}
@@ -0,0 +1,135 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <slapsegiii.h>
+
+namespace
+{
+	/**
+	 * Implementation that, like those written for API 1.2, only
+	 * reads SlapImage::pixels.
+	 */
+	class PixelsOnlyImplementation : public SlapSegIII::Interface
+	{
+	public:
+		SlapSegIII::SubmissionIdentification
+		getIdentification()
+		    const
+		    override
+		{
+			return (SlapSegIII::SubmissionIdentification{});
+		}
+
+		std::tuple<std::set<SlapSegIII::SlapImage::Kind>, bool>
+		getSupported()
+		    const
+		    override
+		{
+			return (std::make_tuple(std::set<SlapSegIII::SlapImage::
+			    Kind>{SlapSegIII::SlapImage::Kind::TwoInch}, true));
+		}
+
+		std::tuple<SlapSegIII::ReturnStatus,
+		    std::vector<SlapSegIII::SegmentationPosition>>
+		segment(
+		    const SlapSegIII::SlapImage &image)
+		    override
+		{
+			this->segmentedPixels = image.pixels;
+			this->segmentedOrientation = image.orientation;
+			return (std::make_tuple(SlapSegIII::ReturnStatus{},
+			    std::vector<SlapSegIII::SegmentationPosition>{}));
+		}
+
+		std::tuple<SlapSegIII::ReturnStatus,
+		    SlapSegIII::SlapImage::Orientation>
+		determineOrientation(
+		    const SlapSegIII::SlapImage&)
+		    override
+		{
+			return (std::make_tuple(SlapSegIII::ReturnStatus{},
+			    SlapSegIII::SlapImage::Orientation::Left));
+		}
+
+		/** Pixels seen by the last call to segment() */
+		std::vector<std::byte> segmentedPixels{};
+		/** Orientation seen by the last call to segment() */
+		SlapSegIII::SlapImage::Orientation segmentedOrientation{};
+	};
+
+	/** Count of failed checks */
+	int failures{0};
+
+	/** Record a failed check. */
+	void
+	check(
+	    const bool condition,
+	    const std::string &description)
+	{
+		if (!condition) {
+			std::cerr << "FAIL: " << description << '\n';
+			++failures;
+		}
+	}
+}
+
+int
+main()
+{
+	std::vector<std::byte> pixels(16 * 8);
+	for (std::size_t i{0}; i < pixels.size(); ++i)
+		pixels[i] = static_cast<std::byte>(i);
+
+	PixelsOnlyImplementation impl{};
+
+	/* Owning image: segment() must see the pixels in `pixels` */
+	const SlapSegIII::SlapImage owning{16, 8, 500,
+	    SlapSegIII::SlapImage::Kind::TwoInch,
+	    SlapSegIII::SlapImage::CaptureTechnology::Unknown,
+	    SlapSegIII::SlapImage::Orientation{}, pixels};
+	impl.segmentAndDetermineOrientation(owning);
+	check(impl.segmentedPixels == pixels, "segmentAndDetermineOrientation"
+	    "() passes owned pixels to segment()");
+	check(impl.segmentedOrientation ==
+	    SlapSegIII::SlapImage::Orientation::Left,
+	    "segmentAndDetermineOrientation() passes the hypothesized "
+	    "orientation to segment()");
+
+	/* Implementations written for API 1.2 only read `pixels` */
+	check(!impl.supportsPixelViews(), "supportsPixelViews() is false "
+	    "unless overridden");
+
+	/* Interned messages are kept in bounded storage */
+	const auto interned = SlapSegIII::internMessage("interned");
+	check(SlapSegIII::internMessage(std::string{"interned"}).data() ==
+	    interned.data(), "internMessage() returns one copy of equal "
+	    "messages");
+	std::string_view last{};
+	for (int i{0}; i < 1000; ++i)
+		last = SlapSegIII::internMessage(std::to_string(i));
+	check(last.empty(), "internMessage() stops copying when its "
+	    "storage is full");
+	check(SlapSegIII::internMessage("interned") == "interned",
+	    "internMessage() keeps earlier messages when its storage is "
+	    "full");
+
+	if (failures != 0)
+		return (EXIT_FAILURE);
+	std::cout << "All checks passed\n";
+	return (EXIT_SUCCESS);
+}
@@ -8,6 +8,7 @@
  * about its quality, reliability, or any other characteristic.
  */
 
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
 
@@ -17,40 +18,103 @@
 #include <algorithm>
 #include <cctype>
 #include <chrono>
+#include <cmath>
+#include <deque>
 #include <exception>
+#include <filesystem>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
 #include <system_error>
 #include <thread>
 
 #include <slapsegiii_validation.h>
 #include <slapsegiii_validation_data.h>
+#include <slapsegiii_validation_latency.h>
+#include <slapsegiii_validation_plugin.h>
 #include <slapsegiii_validation_validate.h>
 #include <slapsegiii_validation_utils.h>
 
-std::string
+namespace
+{
+	/** Directory in which openLog() creates log files */
+	std::filesystem::path logDirectory{"output"};
+	/** Whether readImage() may reference pixels in place */
+	bool pixelViews{false};
+}
+
+void
+SlapSegIII::Validation::compareModes(
+    std::shared_ptr<Interface> impl,
+    const SlapImage::Kind kind,
+    const std::vector<std::string> &keys,
+    const uint16_t numProcs,
+    const Arguments &args)
+{
+	/* Same images, in the same order, through either kind of worker */
+	Arguments processArgs{args};
+	processArgs.numProcs = numProcs;
+	processArgs.numThreads = 1;
+	Arguments threadArgs{args};
+	threadArgs.numProcs = 1;
+
+	/* Only one mode's operation logs are kept with the others */
+	const std::filesystem::path outputDirectory{logDirectory};
+	const auto scratchDirectory = outputDirectory / "compare";
+	std::filesystem::create_directories(scratchDirectory);
+
+	auto compareFile = openLog("compare", kind, COMPARE_LOG_HEADER);
+	for (const auto &[mode, modeArgs, directory] : {
+	    std::make_tuple("process", processArgs, scratchDirectory),
+	    std::make_tuple("thread", threadArgs, outputDirectory)}) {
+		setLogDirectory(directory);
+		const auto start = std::chrono::steady_clock::now();
+		try {
+			runWorkers(impl, kind, keys, modeArgs.numProcs,
+			    modeArgs);
+		} catch (...) {
+			setLogDirectory(outputDirectory);
+			throw;
+		}
+		const auto stop = std::chrono::steady_clock::now();
+		setLogDirectory(outputDirectory);
+
+		compareFile << mode << ',' << ts(modeArgs.numProcs) << ',' <<
+		    modeArgs.numThreads << ',' << std::chrono::duration_cast<
+		    std::chrono::microseconds>(stop - start).count() << '\n';
+		if (!compareFile)
+			throw std::runtime_error(std::to_string(getpid()) +
+			    ": Error writing to log");
+	}
+}
+
+std::tuple<std::string, std::string>
 SlapSegIII::Validation::determineOrientation(
     const std::shared_ptr<Interface> impl,
     const std::string &imageName,
     const Validation::ImageMetadata &md,
-    const SlapImage::Kind kind)
+    const SlapImage::Kind kind,
+    const Arguments &args)
 {
-	std::shared_ptr<SlapImage> si;
-	try {
-		si = std::make_shared<SlapImage>(md.width, md.height, md.ppi,
-		    kind, md.captureTechnology, SlapImage::Orientation{},
-		    readFile(IMAGE_DIR + '/' + imageName));
-	} catch (const std::exception &e) {
-		throw std::runtime_error("Error reading " + imageName + " (" +
-		    e.what() + ")");
-	}
+	const auto latencyBudget = args.latencyBudget;
+	const auto si = readImage(imageName, md, kind,
+	    SlapImage::Orientation{}, args.rowPadding);
 
 	std::tuple<ReturnStatus, SlapImage::Orientation> rv{};
 	std::chrono::steady_clock::time_point start{}, stop{};
 	try {
 		start = std::chrono::steady_clock::now();
-		rv = impl->determineOrientation(*si.get());
+		if (latencyBudget.count() > 0)
+			rv = impl->determineOrientationWithCancellation(si,
+			    CancellationToken{start + latencyBudget});
+		else
+			rv = impl->determineOrientation(si);
 		stop = std::chrono::steady_clock::now();
 	} catch (const std::exception &e) {
 		throw std::runtime_error("Exception while determining "
@@ -60,8 +124,120 @@ SlapSegIII::Validation::determineOrientation(
 		    "orientation of " + imageName);
 	}
 
-	const auto elapsed = std::to_string(std::chrono::duration_cast<
-	    std::chrono::microseconds>(stop - start).count());
+	const auto elapsed = std::chrono::duration_cast<
+	    std::chrono::microseconds>(stop - start);
+	recordLatency({kind, md.ppi, md.captureTechnology}, elapsed);
+	return (std::make_tuple(formatOrientation(imageName, rv, elapsed),
+	    latencyBudget.count() > 0 ? formatBudget(imageName, elapsed,
+	    latencyBudget, std::get<0>(rv).code) : std::string{}));
+}
+
+void
+SlapSegIII::Validation::determineOrientationAsync(
+    TimedAsyncInterface &async,
+    const SlapImage::Kind kind,
+    WorkQueue &keys,
+    const uint16_t numOutstanding,
+    std::ostream &log)
+{
+	struct Pending
+	{
+		std::string imageName{};
+		std::future<TimedAsyncInterface::Result<std::tuple<
+		    ReturnStatus, SlapImage::Orientation>>> result{};
+	};
+	std::deque<Pending> pending{};
+
+	const auto complete = [&]() {
+		auto &p = pending.front();
+		const auto result = p.result.get();
+
+		const auto &md = VALIDATION_DATA.at(kind).at(p.imageName);
+		recordLatency({kind, md.ppi, md.captureTechnology},
+		    result.elapsed);
+		log << formatOrientation(p.imageName, result.value,
+		    result.elapsed);
+		if (!log)
+			throw std::runtime_error(std::to_string(getpid()) +
+			    ": Error writing to log");
+		pending.pop_front();
+	};
+
+	for (const auto &imageName : keys) {
+		pending.push_back({imageName, async.determineOrientation(
+		    imageName, kind)});
+		while (pending.size() >= numOutstanding)
+			complete();
+	}
+	while (!pending.empty())
+		complete();
+}
+
+std::string
+SlapSegIII::Validation::firstCall(
+    const std::shared_ptr<Interface> impl,
+    const std::string &imageName,
+    const SlapImage::Kind kind,
+    const Operation operation)
+{
+	const auto md = VALIDATION_DATA.at(kind).at(imageName);
+	const auto si = readImage(imageName, md, kind,
+	    operation == Operation::Segment ? md.orientation :
+	    SlapImage::Orientation{}, 0);
+
+	ReturnStatus::Code code{};
+	std::chrono::steady_clock::time_point start{}, stop{};
+	try {
+		start = std::chrono::steady_clock::now();
+		switch (operation) {
+		case Operation::Segment:
+			code = std::get<0>(impl->segment(si)).code;
+			break;
+		case Operation::Orientation:
+			code = std::get<0>(impl->determineOrientation(si)).code;
+			break;
+		case Operation::SegmentAndOrientation:
+			code = std::get<0>(std::get<0>(
+			    impl->segmentAndDetermineOrientation(si))).code;
+			break;
+		default:
+			throw std::logic_error("Invalid operation sent to "
+			    "firstCall()");
+		}
+		stop = std::chrono::steady_clock::now();
+	} catch (const std::exception &e) {
+		throw std::runtime_error("Exception during first call with " +
+		    imageName + " (" + e.what() + ")");
+	} catch (...) {
+		throw std::runtime_error("Exception during first call with " +
+		    imageName);
+	}
+
+	return (imageName + ',' + ts(std::chrono::duration_cast<
+	    std::chrono::microseconds>(stop - start).count()) + ',' +
+	    e2i2s(code) + '\n');
+}
+
+std::string
+SlapSegIII::Validation::formatBudget(
+    const std::string &imageName,
+    const std::chrono::microseconds elapsedTime,
+    const std::chrono::milliseconds latencyBudget,
+    const ReturnStatus::Code code)
+{
+	return (imageName + ',' + ts(elapsedTime.count()) + ',' +
+	    ts(std::chrono::duration_cast<std::chrono::microseconds>(
+	    latencyBudget).count()) + ',' + e2i2s(code) + ',' +
+	    std::to_string(elapsedTime > latencyBudget) + '\n');
+}
+
+std::string
+SlapSegIII::Validation::formatOrientation(
+    const std::string &imageName,
+    const std::tuple<ReturnStatus, SlapImage::Orientation> &rv,
+    const std::chrono::microseconds elapsedTime)
+{
+	const auto elapsed = ts(elapsedTime.count());
 
 	std::string logLine{imageName + ',' + elapsed + ',' +
 	    e2i2s(std::get<0>(rv).code) + ',' +
@@ -74,6 +250,121 @@ SlapSegIII::Validation::determineOrientation(
 	return (logLine);
 }
 
+std::string
+SlapSegIII::Validation::formatSegmentation(
+    const std::string &imageName,
+    const Validation::ImageMetadata &md,
+    const SlapImage &image,
+    const std::tuple<ReturnStatus, std::vector<SegmentationPosition>>
+    &rv,
+    const std::chrono::microseconds elapsedTime)
+{
+	/* Enforce correct reporting of image deficiencies */
+	if (((std::get<0>(rv).code == ReturnStatus::Code::RequestRecapture) ||
+	    (std::get<0>(rv).code ==
+	    ReturnStatus::Code::RequestRecaptureWithAttempt)) &&
+	    (std::get<0>(rv).imageDeficiencies.size() == 0))
+		throw std::runtime_error("At least one image deficiency must "
+		    "be set if requesting recapture for image " + imageName);
+	if ((std::get<0>(rv).imageDeficiencies.size() != 0) &&
+	    (std::get<0>(rv).code != ReturnStatus::Code::RequestRecapture) &&
+	    (std::get<0>(rv).code !=
+	    ReturnStatus::Code::RequestRecaptureWithAttempt))
+		throw std::runtime_error("Cannot declare an image deficiency "
+		    "if not requesting a recapture for image " + imageName);
+
+	const auto elapsed = ts(elapsedTime.count());
+
+	std::string logLine{};
+	/* Record all information for successful ReturnStatus values */
+	if (std::get<0>(rv).code == ReturnStatus::Code::Success ||
+	    std::get<0>(rv).code ==
+	    ReturnStatus::Code::RequestRecaptureWithAttempt) {
+		const auto correctQuantity = std::to_string(
+		    Validate::hasCorrectQuantity(std::get<1>(rv),
+		    md.orientation));
+
+		/* Expected SegmentationPositions, but didn't set any */
+		if (std::get<1>(rv).size() == 0) {
+			for (const auto &frgp : Validate::
+			    getExpectedFrictionRidgeGeneralizedPositions(
+			    md.orientation))
+				logLine += imageName + ',' + elapsed + ',' +
+				    e2i2s(std::get<0>(rv).code) + ',' +
+				    sanitizeMessage(std::get<0>(rv).message) +
+				    ',' + e2i2s(frgp) + ",NA,NA,NA,NA,NA,NA,NA,"
+				    "NA,NA,\"ERROR: NIST entered this line on "
+				    "your behalf. You did not set any "
+				    "SegmentationPositions.\",\"\",\"\",0\n";
+		/* Record SegmentationPositions when Result is Success */
+		} else {
+			for (const auto &pos : std::get<1>(rv)) {
+				if (pos.result.code == SegmentationPosition::
+				    Result::Code::Success) {
+					logLine += imageName + ',' + elapsed +
+					    ',' + e2i2s(std::get<0>(rv).code) +
+					    ',' + sanitizeMessage(
+					    std::get<0>(rv).message) +
+					    ',' + e2i2s(pos.frgp) + ',' +
+					    ts(pos.tl.x) + ',' + ts(pos.tl.y) +
+					    ',' + ts(pos.tr.x) + ',' +
+					    ts(pos.tr.y) + ',' + ts(pos.bl.x) +
+					    ',' + ts(pos.bl.y) + ',' +
+					    ts(pos.br.x) + ',' + ts(pos.br.y) +
+					    ',' + e2i2s(pos.result.code) + ',' +
+					    sanitizeMessage(pos.result.
+					    message) + ",\"" + Validate::
+					    validateSegmentationPosition(pos,
+					    image).to_string() + "\",\"" +
+					    Validate::gatherDeficiencies(
+					    std::get<0>(rv)).to_string() +
+					    "\"," + correctQuantity + '\n';
+				} else {
+					logLine += imageName + ',' + elapsed +
+					    ',' +
+					    e2i2s(std::get<0>(rv).code) + ',' +
+					    sanitizeMessage(std::get<0>(rv).
+					    message) +
+					    ',' + e2i2s(pos.frgp) + ",NA,NA,NA,"
+					    "NA,NA,NA,NA,NA," + e2i2s(
+					    pos.result.code) + ',' +
+					    sanitizeMessage(pos.result.
+					    message) + ",\"" + Validate::
+					    validateSegmentationPosition(pos,
+					    image).to_string() + "\",\"" +
+					    Validate::gatherDeficiencies(
+					    std::get<0>(rv)).to_string() +
+					    "\"," + correctQuantity + '\n';
+				}
+			}
+		}
+	/* Don't record SegmentationPositions, but do record Deficiency */
+	} else if (std::get<0>(rv).code ==
+	    ReturnStatus::Code::RequestRecapture) {
+		for (const auto &frgp :
+		    Validate::getExpectedFrictionRidgeGeneralizedPositions(
+		    md.orientation))
+			logLine += imageName + ',' + elapsed + ',' +
+			    e2i2s(std::get<0>(rv).code) + ',' +
+			    sanitizeMessage(std::get<0>(rv).message) + ',' +
+			    e2i2s(frgp) + ",NA,NA,NA,NA,NA,NA,NA,NA,NA,\"\","
+			    "\"\"," + Validate::gatherDeficiencies(std::get<0>(
+			    rv)).to_string() + ",1\n";
+	/* Only record ReturnStatus information */
+	} else {
+		for (const auto &frgp :
+		    Validate::getExpectedFrictionRidgeGeneralizedPositions(
+		    md.orientation))
+			logLine += imageName + ',' + elapsed + ',' +
+			    e2i2s(std::get<0>(rv).code) + ',' +
+			    sanitizeMessage(std::get<0>(rv).message) + ',' +
+			    e2i2s(frgp) + ",NA,NA,NA,NA,NA,NA,NA,NA,NA,\"\","
+			    "\"\",\"\",1\n";
+	}
+
+	return (logLine);
+}
+
 void
 SlapSegIII::Validation::printUsage(
     const std::string &name)
@@ -81,12 +372,281 @@ SlapSegIII::Validation::printUsage(
 	std::cerr << "Usage:\t" << name << " -i(dentify) -z config_dir\n";
 	std::cerr << "\t" << name << " -k(inds of images supported) "
 	    "-z config_dir\n";
-	std::cerr << "\t" << name << " -s(egment) -z config_dir "
-	    "[-r random_seed] [-f num_procs]\n";
-
 	const std::string blankName(name.size(), ' ');
+	std::cerr << "\t" << name << " -s(egment) -z config_dir "
+	    "[-r random_seed] [-f num_procs|auto]\n\t" + blankName +
+	    " [-b batch_size | -a num_outstanding | -u |\n\t" + blankName +
+	    "  -n band_rows[:interval_ms] | -q frames |\n\t" + blankName +
+	    "  [-l budget_ms] [-w row_padding] [-p depth]]\n";
+	std::cerr << "\t" << name << " -s(egment) -z config_dir "
+	    "[-r random_seed]\n\t" + blankName +
+	    " -P core_lib[:config_dir][,core_lib[:config_dir]...]\n";
+	std::cerr << "\tWithout synchronous-only options, -s and -d also "
+	    "accept [-t num_threads [-C]]\n";
+	std::cerr << "\tAll operations that read images also accept "
+	    "[-I buffered|mmap|direct|uring[:evict]] [-M]\n";
+	std::cerr << "\tAll operations without -P also accept "
+	    "[-A compact|scatter|nosmt] [-N] [-v]\n";
 	std::cerr << "\t" << name << " -d(etermine orientation) -z config_dir "
-	    "[-r random_seed]\n\t" + blankName + " [-f num_procs]\n";
+	    "[-r random_seed]\n\t" + blankName + " [-f num_procs|auto] "
+	    "[-a num_outstanding | [-l budget_ms] [-w row_padding]]\n";
+	std::cerr << "\t" << name << " -c(ombined segment and orientation) "
+	    "-z config_dir\n\t" + blankName + " [-r random_seed] "
+	    "[-f num_procs|auto]\n";
+}
+
+SlapSegIII::Validation::CPUBudget
+SlapSegIII::Validation::getCPUBudget()
+{
+	CPUBudget cpus{};
+	cpus.online = static_cast<uint32_t>(std::max<long>(1,
+	    sysconf(_SC_NPROCESSORS_ONLN)));
+
+	try {
+		cpus.affinity = static_cast<uint32_t>(std::max<std::size_t>(1,
+		    getAffinity().size()));
+	} catch (const std::exception&) {
+		cpus.affinity = cpus.online;
+	}
+
+	/* Find the cgroup v2 hierarchy and this process's place in it */
+	std::string mountPoint{}, cgroup{};
+	std::ifstream mounts{"/proc/self/mounts"};
+	for (std::string line{}; std::getline(mounts, line); ) {
+		std::istringstream fields{line};
+		std::string device{}, path{}, type{};
+		if ((fields >> device >> path >> type) && (type == "cgroup2")) {
+			mountPoint = path;
+			break;
+		}
+	}
+	std::ifstream cgroups{"/proc/self/cgroup"};
+	for (std::string line{}; std::getline(cgroups, line); )
+		if (line.starts_with("0::"))
+			cgroup = line.substr(3);
+
+	/* Any ancestor's quota also limits this process */
+	if (!mountPoint.empty() && !cgroup.empty()) {
+		std::filesystem::path dir{mountPoint +
+		    (cgroup == "/" ? "" : cgroup)};
+		while (true) {
+			std::ifstream cpuMax{dir / "cpu.max"};
+			std::string quota{};
+			double period{};
+			if ((cpuMax >> quota >> period) && (quota != "max") &&
+			    (period > 0)) {
+				try {
+					const double cgroupCPUs{std::stod(
+					    quota) / period};
+					if ((cpus.quota == 0) ||
+					    (cgroupCPUs < cpus.quota))
+						cpus.quota = cgroupCPUs;
+				} catch (const std::exception&) {}
+			}
+
+			if ((dir == mountPoint) || !dir.has_relative_path() ||
+			    (dir == dir.parent_path()))
+				break;
+			dir = dir.parent_path();
+		}
+	}
+
+	/* Partial CPUs of quota would only be throttled */
+	cpus.budget = cpus.affinity;
+	if (cpus.quota > 0)
+		cpus.budget = std::clamp<uint32_t>(static_cast<uint32_t>(
+		    std::floor(cpus.quota)), 1, cpus.budget);
+
+	return (cpus);
+}
+
+uint64_t
+SlapSegIII::Validation::getAvailableMemory()
+{
+	std::ifstream meminfo{"/proc/meminfo"};
+	std::string key{};
+	uint64_t value{};
+	while (meminfo >> key >> value) {
+		if (key == "MemAvailable:")
+			return (value * 1024);
+		meminfo.ignore(std::numeric_limits<std::streamsize>::max(),
+		    '\n');
+	}
+
+	return (0);
+}
+
+SlapSegIII::ResourceRequirements
+SlapSegIII::Validation::getKindRequirements(
+    const std::shared_ptr<Interface> impl,
+    const SlapImage::Kind kind)
+{
+	std::set<uint16_t> resolutions{};
+	for (const auto &[name, md] : VALIDATION_DATA.at(kind))
+		resolutions.insert(md.ppi);
+
+	ResourceRequirements largest{};
+	for (const auto &ppi : resolutions) {
+		const auto requirements = impl->getResourceRequirements(kind,
+		    ppi);
+		largest.peakScratchBytes = std::max(largest.peakScratchBytes,
+		    requirements.peakScratchBytes);
+		largest.workingSetBytes = std::max(largest.workingSetBytes,
+		    requirements.workingSetBytes);
+	}
+
+	return (largest);
+}
+
+uint16_t
+SlapSegIII::Validation::limitProcsByMemory(
+    const uint16_t numProcs,
+    const uint16_t numThreads,
+    const ResourceRequirements &requirements,
+    const uint64_t availableMemory)
+{
+	const uint64_t perProcess{requirements.workingSetBytes +
+	    (numThreads * requirements.peakScratchBytes)};
+	if ((perProcess == 0) || (availableMemory == 0))
+		return (numProcs);
+
+	return (static_cast<uint16_t>(std::clamp<uint64_t>(
+	    availableMemory / perProcess, 1, numProcs)));
+}
+
+void
+SlapSegIII::Validation::logMemoryLimit(
+    const SlapImage::Kind kind,
+    const uint16_t requested,
+    const uint16_t allowed,
+    const uint64_t availableMemory,
+    const bool warn)
+{
+	if (warn)
+		std::cerr << "Number of processes: reduced from " <<
+		    requested << " to " << allowed << " for images of kind " <<
+		    e2i2s(kind) << ", to fit in " << availableMemory <<
+		    " bytes of available memory\n";
+
+	auto file = openLog("memory_limit", kind, MEMORY_LIMIT_LOG_HEADER);
+	file << requested << ',' << allowed << ',' << availableMemory << '\n';
+	if (!file)
+		throw std::runtime_error(std::to_string(getpid()) +
+		    ": Error writing to log");
+}
+
+void
+SlapSegIII::Validation::logWorkers(
+    const SlapImage::Kind kind,
+    const std::vector<WorkQueue::WorkerStatistics> &workers)
+{
+	/* Time each worker waited for the slowest to finish */
+	std::chrono::steady_clock::duration slowest{};
+	for (const auto &w : workers)
+		slowest = std::max(slowest, w.elapsed);
+
+	auto workerFile = openLog("workers", kind, WORKER_LOG_HEADER);
+	for (std::size_t i{0}; i < workers.size(); ++i) {
+		const auto &placement = workers[i].placement;
+		workerFile << i << ',' << workers[i].claimed << ',' <<
+		    std::chrono::duration_cast<std::chrono::microseconds>(
+		    workers[i].elapsed).count() << ',' << std::chrono::
+		    duration_cast<std::chrono::microseconds>(slowest -
+		    workers[i].elapsed).count() << ",\"" <<
+		    formatCPUList(placement.cpus) << "\"," <<
+		    (placement.node < 0 ? "" : ts(placement.node)) << '\n';
+	}
+	if (!workerFile)
+		throw std::runtime_error(std::to_string(getpid()) +
+		    ": Error writing to log");
+}
+
+void
+SlapSegIII::Validation::logNodeThroughput(
+    const SlapImage::Kind kind,
+    const std::vector<WorkQueue::WorkerStatistics> &workers)
+{
+	struct NodeTotals
+	{
+		uint16_t workers{0};
+		uint64_t images{0};
+		std::chrono::steady_clock::duration elapsed{};
+	};
+	std::map<int32_t, NodeTotals> nodes{};
+	for (const auto &w : workers) {
+		auto &node = nodes[w.placement.node];
+		++node.workers;
+		node.images += w.claimed;
+		node.elapsed = std::max(node.elapsed, w.elapsed);
+	}
+
+	auto nodeFile = openLog("numa", kind, NUMA_LOG_HEADER);
+	for (const auto &[id, node] : nodes) {
+		const auto elapsed = std::chrono::duration_cast<
+		    std::chrono::microseconds>(node.elapsed);
+		nodeFile << id << ',' << node.workers << ',' << node.images <<
+		    ',' << elapsed.count() << ',' << (elapsed.count() == 0 ?
+		    0.0 : static_cast<double>(node.images) * 1e6 /
+		    static_cast<double>(elapsed.count())) << '\n';
+	}
+	if (!nodeFile)
+		throw std::runtime_error(std::to_string(getpid()) +
+		    ": Error writing to log");
+}
+
+std::ofstream
+SlapSegIII::Validation::openLog(
+    const std::string &prefix,
+    const SlapImage::Kind kind,
+    const std::string &header)
+{
+	return (openLog(prefix + '-' + e2i2s(kind), header));
+}
+
+std::ofstream
+SlapSegIII::Validation::openLog(
+    const std::string &prefix,
+    const std::string &header)
+{
+	std::ofstream file(logDirectory / (prefix + '-' +
+	    std::to_string(getpid()) + ".log"));
+	if (!file) {
+		throw std::runtime_error(std::to_string(getpid()) + ": Error "
+		    "creating log file");
+	}
+
+	file << header << '\n';
+	if (!file)
+		throw std::runtime_error(std::to_string(getpid()) + ": Error "
+		    "writing to log");
+
+	return (file);
+}
+
+SlapSegIII::SlapImage
+SlapSegIII::Validation::jitterImage(
+    const SlapImage &image,
+    const int16_t dx,
+    const int16_t dy,
+    const int16_t brightness)
+{
+	const int32_t width{image.width}, height{image.height};
+	std::vector<std::byte> pixels(static_cast<std::size_t>(width) *
+	    static_cast<std::size_t>(height));
+
+	auto out = pixels.begin();
+	for (int32_t y{0}; y < height; ++y) {
+		const auto row = image.getRow(static_cast<uint16_t>(
+		    std::clamp(y - dy, 0, height - 1)));
+		for (int32_t x{0}; x < width; ++x)
+			*out++ = static_cast<std::byte>(std::clamp(
+			    std::to_integer<int>(row[static_cast<std::size_t>(
+			    std::clamp(x - dx, 0, width - 1))]) + brightness,
+			    0, UINT8_MAX));
+	}
+
+	return (SlapImage{image.width, image.height, image.ppi, image.kind,
+	    image.captureTechnology, image.orientation, std::move(pixels)});
 }
 
 SlapSegIII::Validation::Arguments
@@ -94,7 +654,7 @@ SlapSegIII::Validation::parseArguments(
     int argc,
     char *argv[])
 {
-	static const char options[] {"ikr:sf:dz:"};
+	static const char options[] {"ikr:sf:dz:b:a:cl:uw:n:q:P:I:Mp:t:CA:Nv"};
 
 	bool seenOperation{false};
 	Validation::Arguments args{};
@@ -136,25 +696,31 @@ SlapSegIII::Validation::parseArguments(
 			}
 			break;
 		case 'f': {	/* Number of processes */
+			if (std::string(optarg) == "auto") {
+				args.autoWorkers = true;
+				break;
+			}
+			args.autoWorkers = false;
+
 			try {
 				auto numProcs = std::stoul(optarg);
-				if (numProcs > UINT8_MAX)
+				if (numProcs > UINT16_MAX)
 					throw std::exception{};
-				args.numProcs = static_cast<uint8_t>(numProcs);
+				args.numProcs = static_cast<uint16_t>(numProcs);
 			} catch (const std::exception&) {
 				throw std::invalid_argument{"Number of "
 				    "processes (-f): an error occurred when "
 				    "parsing \"" + std::string(optarg) + "\""};
 			}
 
-			const auto threadCount = std::thread::
-			    hardware_concurrency();
-			if ((threadCount == 0 && args.numProcs > 4) ||
-			    (args.numProcs > threadCount))
+			/* Two processes may always be run to test fork() */
+			const auto cpus = getCPUBudget();
+			if (args.numProcs > std::max<uint32_t>(2, cpus.budget))
 				throw std::invalid_argument{"Number of "
 				    "processes (-f): Asked to spawn " +
 				    std::to_string(args.numProcs) + " "
-				    "processes, but refusing"};
+				    "processes, but refusing (CPU budget is " +
+				    std::to_string(cpus.budget) + ")"};
 			break;
 		}
 		case 'd':
@@ -165,20 +731,331 @@ SlapSegIII::Validation::parseArguments(
 
 			args.operation = Operation::Orientation;
 			break;
-		case 'z':
+		case 'c':
+			if (seenOperation)
+				throw std::logic_error{"Multiple operations "
+				    "specified"};
+			seenOperation = true;
+
+			args.operation = Operation::SegmentAndOrientation;
+			break;
+		case 'z':
 			args.configDir = optarg;
 			break;
+		case 'b': {	/* Batch size */
+			try {
+				const auto batchSize = std::stoul(optarg);
+				if ((batchSize == 0) ||
+				    (batchSize > UINT16_MAX))
+					throw std::exception{};
+				args.batchSize = static_cast<uint16_t>(
+				    batchSize);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Batch size (-b): "
+				    "an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			break;
+		}
+		case 'a': {	/* Number of outstanding requests */
+			try {
+				const auto numOutstanding = std::stoul(optarg);
+				if ((numOutstanding == 0) ||
+				    (numOutstanding > UINT16_MAX))
+					throw std::exception{};
+				args.numOutstanding = static_cast<uint16_t>(
+				    numOutstanding);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Number of "
+				    "outstanding requests (-a): an error "
+				    "occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			break;
+		}
+		case 'p': {	/* Prefetch depth */
+			try {
+				const auto depth = std::stoul(optarg);
+				if ((depth == 0) || (depth > UINT16_MAX))
+					throw std::exception{};
+				args.prefetchDepth = static_cast<uint16_t>(
+				    depth);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Prefetch depth "
+				    "(-p): an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			break;
+		}
+		case 't': {	/* Threads per process */
+			try {
+				const auto numThreads = std::stoul(optarg);
+				if ((numThreads == 0) ||
+				    (numThreads > UINT16_MAX))
+					throw std::exception{};
+				args.numThreads = static_cast<uint16_t>(
+				    numThreads);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Number of threads "
+				    "(-t): an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			break;
+		}
+		case 'C':	/* Compare processes and threads */
+			args.compareModes = true;
+			break;
+		case 'A':	/* CPU placement */
+			try {
+				args.placement = parsePlacement(optarg);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"CPU placement "
+				    "(-A): an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			break;
+		case 'v':	/* Diagnostic logs */
+			args.verbose = true;
+			break;
+		case 'N':	/* Bind workers to NUMA nodes */
+			args.bindNodes = true;
+			break;
+		case 'M':	/* Shared image corpus */
+			args.sharedCorpus = true;
+			break;
+		case 'u':	/* Reuse output storage */
+			args.reuseOutput = true;
+			break;
+		case 'w': {	/* Row padding */
+			try {
+				const auto rowPadding = std::stoul(optarg);
+				if ((rowPadding == 0) ||
+				    (rowPadding > UINT16_MAX))
+					throw std::exception{};
+				args.rowPadding = static_cast<uint16_t>(
+				    rowPadding);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Row padding (-w): "
+				    "an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			break;
+		}
+		case 'q': {	/* Frames per session */
+			try {
+				const auto numFrames = std::stoul(optarg);
+				if ((numFrames == 0) ||
+				    (numFrames > UINT16_MAX))
+					throw std::exception{};
+				args.numFrames = static_cast<uint16_t>(
+				    numFrames);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Number of frames "
+				    "(-q): an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			break;
+		}
+		case 'n': {	/* Streamed bands */
+			const std::string value{optarg};
+			const auto colon = value.find(':');
+			try {
+				const auto bandRows = std::stoul(
+				    value.substr(0, colon));
+				if ((bandRows == 0) || (bandRows > UINT16_MAX))
+					throw std::exception{};
+				args.bandRows = static_cast<uint16_t>(bandRows);
+
+				if (colon != std::string::npos)
+					args.bandInterval = std::chrono::
+					    milliseconds(std::stoul(
+					    value.substr(colon + 1)));
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Streamed bands "
+				    "(-n): an error occurred when parsing \"" +
+				    value + "\""};
+			}
+			break;
+		}
+		case 'P': {	/* Core libraries loaded at runtime */
+			std::string value{optarg};
+			std::string::size_type start{0}, comma{};
+			do {
+				comma = value.find(',', start);
+				const auto entry = value.substr(start,
+				    comma == std::string::npos ?
+				    std::string::npos : comma - start);
+				const auto colon = entry.find(':');
+				const auto path = entry.substr(0, colon);
+				const auto configDir = (colon ==
+				    std::string::npos ? std::string{} :
+				    entry.substr(colon + 1));
+				if (path.empty() || ((colon !=
+				    std::string::npos) && configDir.empty()))
+					throw std::invalid_argument{"Core "
+					    "libraries (-P): an error occurred "
+					    "when parsing \"" + value + "\""};
+				args.plugins.push_back({path, configDir});
+				start = comma + 1;
+			} while (comma != std::string::npos);
+			break;
+		}
+		case 'I': {	/* I/O backend */
+			const std::string value{optarg};
+			const auto colon = value.find(':');
+			try {
+				args.ioBackend = parseIOBackend(
+				    value.substr(0, colon));
+				if (colon != std::string::npos) {
+					if (value.substr(colon + 1) != "evict")
+						throw std::exception{};
+					args.evictBeforeRead = true;
+				}
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"I/O backend (-I): "
+				    "an error occurred when parsing \"" +
+				    value + "\""};
+			}
+			break;
+		}
+		case 'l': {	/* Latency budget */
+			try {
+				const auto budget = std::stoul(optarg);
+				if (budget == 0)
+					throw std::exception{};
+				args.latencyBudget = std::chrono::milliseconds(
+				    budget);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Latency budget "
+				    "(-l): an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			break;
+		}
 		}
 	}
 
+	if ((args.batchSize > 1) && (args.numOutstanding > 0))
+		throw std::invalid_argument{"Batch size (-b) and number of "
+		    "outstanding requests (-a) are mutually exclusive"};
+	if ((args.numOutstanding > 0) &&
+	    (args.operation == Operation::SegmentAndOrientation))
+		throw std::invalid_argument{"Number of outstanding requests "
+		    "(-a): not valid when combining operations"};
+	if ((args.latencyBudget.count() > 0) && ((args.batchSize > 1) ||
+	    (args.numOutstanding > 0) ||
+	    (args.operation == Operation::SegmentAndOrientation)))
+		throw std::invalid_argument{"Latency budget (-l): only valid "
+		    "with synchronous calls to segment() or "
+		    "determineOrientation()"};
+	if (args.reuseOutput && ((args.operation != Operation::Segment) ||
+	    (args.batchSize > 1) || (args.numOutstanding > 0) ||
+	    (args.latencyBudget.count() > 0)))
+		throw std::invalid_argument{"Reuse output storage (-u): only "
+		    "valid with synchronous calls to segment()"};
+	if ((args.numFrames > 0) && ((args.operation != Operation::Segment) ||
+	    (args.batchSize > 1) || (args.numOutstanding > 0) ||
+	    args.reuseOutput || (args.latencyBudget.count() > 0) ||
+	    (args.rowPadding > 0) || (args.bandRows > 0)))
+		throw std::invalid_argument{"Number of frames (-q): only valid "
+		    "with synchronous calls to segment()"};
+	if ((args.bandRows > 0) && ((args.operation != Operation::Segment) ||
+	    (args.batchSize > 1) || (args.numOutstanding > 0) ||
+	    args.reuseOutput || (args.latencyBudget.count() > 0) ||
+	    (args.rowPadding > 0)))
+		throw std::invalid_argument{"Streamed bands (-n): only valid "
+		    "with synchronous calls to segment()"};
+	if ((args.rowPadding > 0) && ((args.batchSize > 1) ||
+	    (args.numOutstanding > 0) || args.reuseOutput ||
+	    (args.operation == Operation::SegmentAndOrientation)))
+		throw std::invalid_argument{"Row padding (-w): only valid with "
+		    "synchronous calls to segment() or "
+		    "determineOrientation()"};
+	if ((args.batchSize > 1) && (args.operation != Operation::Segment))
+		throw std::invalid_argument{"Batch size (-b): only valid when "
+		    "segmenting"};
+	if ((args.numThreads > 1) && (args.autoWorkers ||
+	    requiresSynchronousCalls(args)))
+		throw std::invalid_argument{"Number of threads (-t): only "
+		    "valid with asynchronous calls to segment() or "
+		    "determineOrientation()"};
+	if (args.compareModes && ((args.numThreads < 2) ||
+	    (args.numProcs > 1)))
+		throw std::invalid_argument{"Compare processes and threads "
+		    "(-C): requires -t 2 or more, without -f"};
+	if ((args.prefetchDepth > 0) && ((args.operation !=
+	    Operation::Segment) || (args.batchSize > 1) ||
+	    (args.numOutstanding > 0) || args.reuseOutput ||
+	    (args.bandRows > 0) || (args.numFrames > 0) ||
+	    !args.plugins.empty()))
+		throw std::invalid_argument{"Prefetch depth (-p): only valid "
+		    "with synchronous calls to segment()"};
+	if (!args.plugins.empty() && ((args.operation != Operation::Segment) ||
+	    (args.numProcs > 1) || args.autoWorkers || (args.batchSize > 1) ||
+	    (args.numOutstanding > 0) || args.reuseOutput ||
+	    (args.latencyBudget.count() > 0) || (args.rowPadding > 0) ||
+	    (args.bandRows > 0) || (args.numFrames > 0)))
+		throw std::invalid_argument{"Core libraries (-P): only valid "
+		    "with synchronous calls to segment() in one process"};
+	if (!args.plugins.empty() && args.sharedCorpus)
+		throw std::invalid_argument{"Shared corpus (-M): not valid "
+		    "with core libraries (-P), which already share images"};
+	if (!args.plugins.empty() && (args.placement != Placement::None))
+		throw std::invalid_argument{"CPU placement (-A): not valid "
+		    "with core libraries (-P)"};
+	if (args.bindNodes && (!args.plugins.empty() || args.sharedCorpus ||
+	    (args.ioBackend == IOBackend::MemoryMapped)))
+		throw std::invalid_argument{"Bind to NUMA nodes (-N): not "
+		    "valid with -P, -M, or -I mmap, whose workers share one "
+		    "copy of each image"};
+
 	if (!seenOperation)
 		args.operation = Operation::Usage;
 	if (args.configDir.empty())
 		args.operation = Operation::Usage;
+	for (auto &plugin : args.plugins)
+		if (plugin.configDir.empty())
+			plugin.configDir = args.configDir;
 
 	return (args);
 }
 
+bool
+SlapSegIII::Validation::requiresSynchronousCalls(
+    const Arguments &args)
+{
+	return ((args.operation == Operation::SegmentAndOrientation) ||
+	    (args.batchSize > 1) || args.reuseOutput ||
+	    (args.latencyBudget.count() > 0) || (args.rowPadding > 0) ||
+	    (args.bandRows > 0) || (args.numFrames > 0) ||
+	    (args.prefetchDepth > 0) || !args.plugins.empty());
+}
+
+std::tuple<uint16_t, uint16_t>
+SlapSegIII::Validation::planWorkers(
+    const ConcurrencyCapabilities &capabilities,
+    const uint32_t cpuBudget)
+{
+	/* Number of calls that can run without oversubscribing cores */
+	const uint32_t threadsPerCall{std::max<uint32_t>(1,
+	    capabilities.threadsPerCall)};
+	const uint32_t slots{std::max<uint32_t>(1, cpuBudget / threadsPerCall)};
+
+	/* Fill slots with threads of as few processes as possible */
+	uint32_t numThreads{1};
+	if (capabilities.reentrant) {
+		numThreads = std::min<uint32_t>(slots, UINT16_MAX);
+		if (capabilities.maxConcurrentCalls != 0)
+			numThreads = std::min<uint32_t>(numThreads,
+			    capabilities.maxConcurrentCalls);
+	}
+	const uint32_t numProcs{std::clamp<uint32_t>(slots / numThreads, 1,
+	    UINT16_MAX)};
+
+	return (std::make_tuple(static_cast<uint16_t>(numProcs),
+	    static_cast<uint16_t>(numThreads)));
+}
+
 void
 SlapSegIII::Validation::printIdentification(
     const std::filesystem::path &configDir)
@@ -196,9 +1073,10 @@ void
 SlapSegIII::Validation::printSupported(
     const std::filesystem::path &configDir)
 {
-	const auto rv = SlapSegIII::Interface::getImplementation(configDir)->
-	    getSupported();
+	const auto impl = SlapSegIII::Interface::getImplementation(configDir);
+	const auto rv = impl->getSupported();
 	const auto kinds = std::get<0>(rv);
+	const auto concurrency = impl->getConcurrencyCapabilities();
 
 	std::cout << std::boolalpha <<
 	    "TwoInch = " <<
@@ -209,58 +1087,719 @@ SlapSegIII::Validation::printSupported(
 	    (kinds.find(SlapImage::Kind::UpperPalm) != kinds.cend()) <<
 	    "\nFullPalm = " <<
 	    (kinds.find(SlapImage::Kind::FullPalm) != kinds.cend()) <<
-	    "\nDetermineOrientation = " << std::get<1>(rv) << '\n';
+	    "\nDetermineOrientation = " << std::get<1>(rv) <<
+	    "\nReentrant = " << concurrency.reentrant <<
+	    "\nMaxConcurrentCalls = " << concurrency.maxConcurrentCalls <<
+	    "\nThreadsPerCall = " << concurrency.threadsPerCall << '\n';
 }
 
-std::vector<std::byte>
-SlapSegIII::Validation::readFile(
-    const std::string &pathName)
+std::string
+SlapSegIII::Validation::readMemoryUsage()
 {
-	std::ifstream file{pathName,
-	    std::ifstream::ate | std::ifstream::binary};
-	if (!file)
-		throw std::runtime_error{"Could not open " + pathName};
-	file.unsetf(std::ifstream::skipws);
+	static const std::vector<std::string> fields{"Rss:", "Pss:",
+	    "Shared_Clean:", "Shared_Dirty:", "Private_Clean:",
+	    "Private_Dirty:"};
+	std::vector<std::string> values(fields.size(), "NA");
+
+	std::ifstream rollup{"/proc/self/smaps_rollup"};
+	std::string key{}, value{};
+	while (rollup >> key >> value) {
+		const auto it = std::find(fields.cbegin(), fields.cend(), key);
+		if (it != fields.cend())
+			values[static_cast<std::size_t>(std::distance(
+			    fields.cbegin(), it))] = value;
+		rollup.ignore(std::numeric_limits<std::streamsize>::max(),
+		    '\n');
+	}
+
+	std::string logLine{};
+	for (const auto &v : values)
+		logLine += (logLine.empty() ? "" : ",") + v;
+	return (logLine + '\n');
+}
 
-	const auto size = file.tellg();
-	if (size == -1)
-		throw std::runtime_error{"Could not open " + pathName};
+SlapSegIII::SlapImage
+SlapSegIII::Validation::readImage(
+    const std::string &imageName,
+    const Validation::ImageMetadata &md,
+    const SlapImage::Kind kind,
+    const SlapImage::Orientation orientation,
+    const uint16_t rowPadding)
+{
+	SlapImage image{};
+	try {
+		auto contents = readFile(IMAGE_DIR + '/' + imageName);
+		const auto pixels = contents.getBytes();
+
+		if ((rowPadding == 0) && (contents.owner != nullptr) &&
+		    pixelViews) {
+			/* Mapped or aligned buffer is referenced in place */
+			image = SlapImage{md.width, md.height, md.ppi, kind,
+			    md.captureTechnology, orientation, pixels,
+			    std::move(contents.owner)};
+		} else if (rowPadding == 0) {
+			/* Implementation only reads SlapImage::pixels */
+			if (contents.owner != nullptr)
+				contents.buffer.assign(pixels.begin(),
+				    pixels.end());
+
+			/* Image buffer is moved, not copied, into SlapImage */
+			image = SlapImage{md.width, md.height, md.ppi, kind,
+			    md.captureTechnology, orientation,
+			    std::move(contents.buffer)};
+		} else {
+			if (pixels.size() != (static_cast<std::size_t>(
+			    md.width) * md.height))
+				throw std::runtime_error{"Expected " +
+				    ts(static_cast<std::size_t>(md.width) *
+				    md.height) + " bytes, read " +
+				    ts(pixels.size())};
+
+			/* Region of a larger, padded (device) buffer */
+			const std::size_t stride{static_cast<std::size_t>(
+			    md.width) + rowPadding};
+			const uint16_t xOffset{static_cast<uint16_t>(
+			    rowPadding / 2)};
+			std::vector<std::byte> padded(stride * md.height,
+			    std::byte{0xFF});
+			for (std::size_t row{0}; row < md.height; ++row)
+				std::copy_n(std::next(pixels.begin(),
+				    static_cast<std::ptrdiff_t>(row *
+				    md.width)), md.width, std::next(
+				    padded.begin(), static_cast<std::ptrdiff_t>(
+				    (row * stride) + xOffset)));
+
+			image = SlapImage{md.width, md.height, md.ppi, kind,
+			    md.captureTechnology, orientation,
+			    std::move(padded)};
+			image.rowStride = static_cast<uint32_t>(stride);
+			image.xOffset = xOffset;
+		}
+	} catch (const std::exception &e) {
+		throw std::runtime_error("Error reading " + imageName + " (" +
+		    e.what() + ")");
+	}
 
-	std::vector<std::byte> buf{};
-	buf.resize(static_cast<decltype(buf)::size_type>(size));
+	if (!image.hasValidLayout())
+		throw std::runtime_error("Image data of " + imageName + " is "
+		    "smaller than its layout requires");
 
-	file.seekg(std::ifstream::beg);
-	file.read(reinterpret_cast<char*>(buf.data()), size);
+	return (image);
+}
 
-	return (buf);
+SlapSegIII::Validation::ScratchArena::ScratchArena(
+    const std::size_t size,
+    std::pmr::memory_resource *upstream) :
+    buffer(size),
+    upstream{upstream}
+{
+
+}
+
+void*
+SlapSegIII::Validation::ScratchArena::do_allocate(
+    std::size_t bytes,
+    std::size_t alignment)
+{
+	void *p{this->buffer.data() + this->offset};
+	std::size_t space{this->buffer.size() - this->offset};
+	if (std::align(alignment, bytes, p, space) == nullptr)
+		return (this->upstream->allocate(bytes, alignment));
+
+	this->offset = static_cast<std::size_t>(static_cast<std::byte*>(p) -
+	    this->buffer.data()) + bytes;
+	++this->liveAllocations;
+	return (p);
 }
 
 void
-SlapSegIII::Validation::runSegment(
+SlapSegIII::Validation::ScratchArena::do_deallocate(
+    void *p,
+    std::size_t bytes,
+    std::size_t alignment)
+{
+	const auto address = static_cast<std::byte*>(p);
+	if ((address < this->buffer.data()) ||
+	    (address >= this->buffer.data() + this->buffer.size())) {
+		this->upstream->deallocate(p, bytes, alignment);
+		return;
+	}
+
+	/* Reclaim the whole buffer once nothing is outstanding */
+	if (--this->liveAllocations == 0)
+		this->offset = 0;
+}
+
+bool
+SlapSegIII::Validation::ScratchArena::do_is_equal(
+    const std::pmr::memory_resource &other)
+    const
+    noexcept
+{
+	return (this == &other);
+}
+
+SlapSegIII::Validation::WorkQueue::Iterator::Iterator(
+    WorkQueue *queue,
+    const std::size_t index) :
+    queue{queue},
+    index{index}
+{
+
+}
+
+SlapSegIII::Validation::WorkQueue::Iterator::reference
+SlapSegIII::Validation::WorkQueue::Iterator::operator*()
+    const
+{
+	return (this->queue->keys[this->index]);
+}
+
+SlapSegIII::Validation::WorkQueue::Iterator&
+SlapSegIII::Validation::WorkQueue::Iterator::operator++()
+{
+	this->index = std::get<0>(this->queue->claimIndex(1));
+	return (*this);
+}
+
+bool
+SlapSegIII::Validation::WorkQueue::Iterator::operator==(
+    const Iterator &other)
+    const
+    noexcept
+{
+	return ((this->queue == other.queue) && (this->index == other.index));
+}
+
+SlapSegIII::Validation::WorkQueue::WorkQueue(
+    const std::vector<std::string> &keys,
+    const uint16_t numWorkers) :
+    keys{keys},
+    numWorkers{std::max<uint16_t>(1, numWorkers)},
+    start{std::chrono::steady_clock::now()}
+{
+	static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+	    std::atomic<int64_t>::is_always_lock_free,
+	    "Atomics in shared memory must be lock-free");
+
+	/* Shared, so updates from forked children are seen by all */
+	this->mappingSize = sizeof(std::atomic<uint64_t>) +
+	    (this->numWorkers * sizeof(Worker));
+	this->mapping = ::mmap(nullptr, this->mappingSize,
+	    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (this->mapping == MAP_FAILED)
+		throw std::runtime_error{"Could not map work queue (" +
+		    std::system_error(errno, std::system_category()).code().
+		    message() + ")"};
+
+	this->next = new (this->mapping) std::atomic<uint64_t>{0};
+	this->workers = new (static_cast<std::byte*>(this->mapping) +
+	    sizeof(std::atomic<uint64_t>)) Worker[this->numWorkers]{};
+}
+
+SlapSegIII::Validation::WorkQueue::~WorkQueue()
+{
+	::munmap(this->mapping, this->mappingSize);
+}
+
+SlapSegIII::Validation::WorkQueue::Iterator
+SlapSegIII::Validation::WorkQueue::begin()
+{
+	return (Iterator{this, std::get<0>(this->claimIndex(1))});
+}
+
+SlapSegIII::Validation::WorkQueue::Iterator
+SlapSegIII::Validation::WorkQueue::end()
+{
+	return (Iterator{this, this->keys.size()});
+}
+
+std::span<const std::string>
+SlapSegIII::Validation::WorkQueue::claim(
+    const std::size_t count)
+{
+	const auto [first, claimed] = this->claimIndex(count);
+	return (std::span<const std::string>{this->keys}.subspan(first,
+	    claimed));
+}
+
+const std::string*
+SlapSegIII::Validation::WorkQueue::peek()
+{
+	auto index = this->peeked.load(std::memory_order_relaxed);
+	if (index == SIZE_MAX) {
+		index = std::get<0>(this->claimIndex(1));
+		this->peeked.store(index, std::memory_order_relaxed);
+	}
+
+	return (index < this->keys.size() ? &(this->keys[index]) : nullptr);
+}
+
+std::tuple<std::size_t, std::size_t>
+SlapSegIII::Validation::WorkQueue::claimIndex(
+    const std::size_t count)
+{
+	/* A peeked key was counted when peeked, and is handed out alone */
+	const auto peeked = this->peeked.exchange(SIZE_MAX,
+	    std::memory_order_relaxed);
+	if (peeked != SIZE_MAX)
+		return {peeked, peeked < this->keys.size() ? 1 : 0};
+
+	/* Once exhausted, the counter may run past the end */
+	const auto first = static_cast<std::size_t>(this->next->fetch_add(
+	    count, std::memory_order_relaxed));
+	if (first >= this->keys.size())
+		return {this->keys.size(), 0};
+
+	const auto claimed = std::min(count, this->keys.size() - first);
+	this->workers[this->worker].claimed.fetch_add(claimed,
+	    std::memory_order_relaxed);
+	return {first, claimed};
+}
+
+const std::vector<std::string>&
+SlapSegIII::Validation::WorkQueue::getKeys()
+    const
+    noexcept
+{
+	return (this->keys);
+}
+
+void
+SlapSegIII::Validation::WorkQueue::setWorker(
+    const uint16_t worker)
+{
+	if (worker >= this->numWorkers)
+		throw std::out_of_range{"Worker " + std::to_string(worker) +
+		    " of " + std::to_string(this->numWorkers)};
+	this->worker = worker;
+}
+
+void
+SlapSegIII::Validation::WorkQueue::finish()
+{
+	this->workers[this->worker].elapsed.store(
+	    (std::chrono::steady_clock::now() - this->start).count(),
+	    std::memory_order_relaxed);
+}
+
+std::vector<SlapSegIII::Validation::WorkQueue::WorkerStatistics>
+SlapSegIII::Validation::WorkQueue::getWorkerStatistics()
+    const
+{
+	std::vector<WorkerStatistics> statistics{};
+	statistics.reserve(this->numWorkers);
+	for (uint16_t i{0}; i < this->numWorkers; ++i)
+		statistics.push_back({this->workers[i].claimed.load(),
+		    std::chrono::steady_clock::duration(
+		    this->workers[i].elapsed.load())});
+
+	return (statistics);
+}
+
+std::future<SlapSegIII::Validation::TimedAsyncInterface::Result<
+    std::tuple<SlapSegIII::ReturnStatus,
+    std::vector<SlapSegIII::SegmentationPosition>>>>
+SlapSegIII::Validation::TimedAsyncInterface::segment(
+    const std::string &imageName,
+    const SlapImage::Kind kind)
+{
+	using Value = std::tuple<ReturnStatus,
+	    std::vector<SegmentationPosition>>;
+	auto task = std::make_shared<std::packaged_task<Result<Value>()>>(
+	    [impl = this->implementation, imageName, kind]() {
+		const auto &md = VALIDATION_DATA.at(kind).at(imageName);
+		Result<Value> result{readImage(imageName, md, kind,
+		    md.orientation, 0)};
+
+		std::chrono::steady_clock::time_point start{}, stop{};
+		try {
+			start = std::chrono::steady_clock::now();
+			result.value = impl->segment(result.image);
+			stop = std::chrono::steady_clock::now();
+		} catch (const std::exception &e) {
+			throw std::runtime_error("Exception while segmenting " +
+			    imageName + " (" + e.what() + ")");
+		} catch (...) {
+			throw std::runtime_error("Exception while segmenting " +
+			    imageName);
+		}
+
+		result.elapsed = std::chrono::duration_cast<
+		    std::chrono::microseconds>(stop - start);
+		return (result);
+	    });
+	auto future = task->get_future();
+	this->enqueue([task]() { (*task)(); });
+
+	return (future);
+}
+
+std::future<SlapSegIII::Validation::TimedAsyncInterface::Result<
+    std::tuple<SlapSegIII::ReturnStatus,
+    SlapSegIII::SlapImage::Orientation>>>
+SlapSegIII::Validation::TimedAsyncInterface::determineOrientation(
+    const std::string &imageName,
+    const SlapImage::Kind kind)
+{
+	using Value = std::tuple<ReturnStatus, SlapImage::Orientation>;
+	auto task = std::make_shared<std::packaged_task<Result<Value>()>>(
+	    [impl = this->implementation, imageName, kind]() {
+		const auto &md = VALIDATION_DATA.at(kind).at(imageName);
+		Result<Value> result{readImage(imageName, md, kind,
+		    SlapImage::Orientation{}, 0)};
+
+		std::chrono::steady_clock::time_point start{}, stop{};
+		try {
+			start = std::chrono::steady_clock::now();
+			result.value = impl->determineOrientation(
+			    result.image);
+			stop = std::chrono::steady_clock::now();
+		} catch (const std::exception &e) {
+			throw std::runtime_error("Exception while determining "
+			    "orientation of " + imageName + " (" + e.what() +
+			    ")");
+		} catch (...) {
+			throw std::runtime_error("Exception while determining "
+			    "orientation of " + imageName);
+		}
+
+		result.elapsed = std::chrono::duration_cast<
+		    std::chrono::microseconds>(stop - start);
+		return (result);
+	    });
+	auto future = task->get_future();
+	this->enqueue([task]() { (*task)(); });
+
+	return (future);
+}
+
+SlapSegIII::Validation::ImagePrefetcher::ImagePrefetcher(
+    const SlapImage::Kind kind,
+    WorkQueue &keys,
+    const uint16_t depth,
+    const uint16_t rowPadding) :
+    kind{kind},
+    keys{keys},
+    depth{std::max<std::size_t>(1, depth)},
+    rowPadding{rowPadding}
+{
+	this->reader = std::thread(&ImagePrefetcher::read, this);
+}
+
+SlapSegIII::Validation::ImagePrefetcher::~ImagePrefetcher()
+{
+	{
+		std::lock_guard<std::mutex> lock{this->mutex};
+		this->stopping = true;
+	}
+	this->imageDequeued.notify_one();
+	this->reader.join();
+}
+
+std::optional<std::pair<std::string, SlapSegIII::SlapImage>>
+SlapSegIII::Validation::ImagePrefetcher::next()
+{
+	std::unique_lock<std::mutex> lock{this->mutex};
+	if (this->queue.empty()) {
+		const auto start = std::chrono::steady_clock::now();
+		this->imageQueued.wait(lock, [this]() {
+			return (!this->queue.empty() || this->finished ||
+			    (this->error != nullptr)); });
+		this->starved += std::chrono::steady_clock::now() - start;
+	}
+	if (this->queue.empty()) {
+		if (this->error != nullptr)
+			std::rethrow_exception(this->error);
+		return (std::nullopt);
+	}
+
+	auto image = std::move(this->queue.front());
+	this->queue.pop_front();
+	lock.unlock();
+
+	this->imageDequeued.notify_one();
+	return (image);
+}
+
+std::chrono::microseconds
+SlapSegIII::Validation::ImagePrefetcher::getStarvedTime()
+    const
+{
+	std::lock_guard<std::mutex> lock{this->mutex};
+	return (std::chrono::duration_cast<std::chrono::microseconds>(
+	    this->starved));
+}
+
+void
+SlapSegIII::Validation::ImagePrefetcher::read()
+{
+	try {
+		for (const auto &imageName : this->keys) {
+			const auto &md = VALIDATION_DATA.at(this->kind).at(
+			    imageName);
+			auto image = readImage(imageName, md, this->kind,
+			    md.orientation, this->rowPadding);
+
+			std::unique_lock<std::mutex> lock{this->mutex};
+			this->imageDequeued.wait(lock, [this]() {
+				return (this->stopping ||
+				    (this->queue.size() < this->depth)); });
+			if (this->stopping)
+				return;
+			this->queue.emplace_back(imageName, std::move(image));
+			lock.unlock();
+
+			this->imageQueued.notify_one();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock{this->mutex};
+			this->finished = true;
+		}
+		this->imageQueued.notify_one();
+	} catch (...) {
+		{
+			std::lock_guard<std::mutex> lock{this->mutex};
+			this->error = std::current_exception();
+		}
+		this->imageQueued.notify_one();
+	}
+}
+
+void
+SlapSegIII::Validation::runOperation(
     std::shared_ptr<Interface> impl,
     const SlapImage::Kind kind,
-    const std::vector<std::string> &keys)
+    WorkQueue &keys,
+    const Arguments &args)
 {
-	std::ofstream file("output/segments-" + e2i2s(kind) + '-' +
-	    std::to_string(getpid()) + ".log");
-	if (!file) {
-		throw std::runtime_error(std::to_string(getpid()) + ": Error "
-		    "creating log file");
+	/* Only count images read for this kind by this worker */
+	resetIOStatistics();
+
+	/* Scratch memory for synchronous calls, allocated once */
+	struct ArenaGuard
+	{
+		std::shared_ptr<Interface> impl{};
+		std::unique_ptr<ScratchArena> arena{};
+
+		/* Withdraw the arena before it is destroyed, even on error */
+		~ArenaGuard()
+		{
+			if (this->arena)
+				this->impl->setMemoryResource(nullptr);
+		}
+	} guard{impl, {}};
+	if ((args.numThreads <= 1) && (args.numOutstanding == 0)) {
+		const auto scratch = getKindRequirements(impl, kind).
+		    peakScratchBytes;
+		if ((scratch > 0) && (scratch <= SIZE_MAX)) {
+			guard.arena = std::make_unique<ScratchArena>(
+			    static_cast<std::size_t>(scratch));
+			impl->setMemoryResource(guard.arena.get());
+		}
 	}
 
-	static const std::string header{"name,elapsed,rCode,\"rMessage\",frgp,"
-	    "tlx,tly,trx,try,blx,bly,brx,bry,sCode,\"sMessage\",\"errors\","
-	    "\"deficiencies\",correctQuantity"};
-	file << header << '\n';
-	if (!file)
-		throw std::runtime_error(std::to_string(getpid()) + ": Error "
-		    "writing to log");
+	/*
+	 * Keep one-time costs of the first call out of the main log,
+	 * warming up on the image this worker will process first.
+	 */
+	const auto first = keys.peek();
+	if ((first != nullptr) && ((args.operation == Operation::Segment) ||
+	    std::get<1>(impl->getSupported()))) {
+		const auto entry = firstCall(impl, *first, kind,
+		    args.operation);
+		if (args.verbose) {
+			auto file = openLog("firstcall", kind,
+			    FIRST_CALL_LOG_HEADER);
+			file << entry;
+			if (!file)
+				throw std::runtime_error(std::to_string(
+				    getpid()) + ": Error writing to log");
+		}
+	}
+
+	switch (args.operation) {
+	case Operation::Segment:
+		runSegment(impl, kind, keys, args);
+		break;
+	case Operation::Orientation:
+		runDetermineOrientation(impl, kind, keys, args);
+		break;
+	case Operation::SegmentAndOrientation:
+		runSegmentAndDetermineOrientation(impl, kind, keys);
+		break;
+	default:
+		throw std::runtime_error("Invalid operation sent to "
+		    "runOperation()");
+	}
+
+	if (!args.verbose)
+		return;
+
+	/* How much of this worker's memory is shared with others */
+	auto memoryFile = openLog("memory", kind, MEMORY_LOG_HEADER);
+	memoryFile << readMemoryUsage();
+	if (!memoryFile)
+		throw std::runtime_error(std::to_string(getpid()) +
+		    ": Error writing to log");
+
+	auto ioFile = openLog("io", kind, IO_LOG_HEADER);
+	ioFile << formatIOStatistics();
+	if (!ioFile)
+		throw std::runtime_error(std::to_string(getpid()) +
+		    ": Error writing to log");
+}
+
+void
+SlapSegIII::Validation::runSegmentAndDetermineOrientation(
+    std::shared_ptr<Interface> impl,
+    const SlapImage::Kind kind,
+    WorkQueue &keys)
+{
+	/* Combined call is only meaningful when orientation is determined */
+	if (!std::get<1>(impl->getSupported()))
+		throw std::runtime_error("Implementation does not support "
+		    "determining orientation");
+
+	auto segmentsFile = openLog("segments", kind, SEGMENTATION_LOG_HEADER);
+	auto orientationFile = openLog("orientation", kind,
+	    ORIENTATION_LOG_HEADER);
 
 	for (const auto &imageName : keys) {
 		const auto md = VALIDATION_DATA.at(kind).at(imageName);
-		file << segment(impl, imageName, md, kind);
+		const auto [segmentsLog, orientationLog] =
+		    segmentAndDetermineOrientation(impl, imageName, md, kind);
+		segmentsFile << segmentsLog;
+		orientationFile << orientationLog;
+
+		if (!segmentsFile || !orientationFile)
+			throw std::runtime_error(std::to_string(getpid()) +
+			    ": Error writing to log");
+	}
+}
+
+void
+SlapSegIII::Validation::runSegment(
+    std::shared_ptr<Interface> impl,
+    const SlapImage::Kind kind,
+    WorkQueue &keys,
+    const Arguments &args)
+{
+	auto file = openLog("segments", kind, SEGMENTATION_LOG_HEADER);
+
+	if (args.batchSize > 1) {
+		for (auto batch = keys.claim(args.batchSize); !batch.empty();
+		    batch = keys.claim(args.batchSize)) {
+			file << segmentBatch(impl, batch, kind);
+
+			if (!file)
+				throw std::runtime_error(std::to_string(
+				    getpid()) + ": Error writing to log");
+		}
+		return;
+	}
+
+	if ((args.numOutstanding > 0) || (args.numThreads > 1)) {
+		TimedAsyncInterface async{impl, args.numThreads};
+		segmentAsync(async, kind, keys, std::max(args.numOutstanding,
+		    args.numThreads), file);
+		return;
+	}
+
+	if (args.numFrames > 0) {
+		std::mt19937_64 rng{args.randomSeed};
+		auto sequenceFile = openLog("segments_sequence", kind,
+		    SEQUENCE_LOG_HEADER);
+		for (const auto &imageName : keys) {
+			const auto md = VALIDATION_DATA.at(kind).at(imageName);
+			const auto [segmentsLog, sequenceLog] =
+			    segmentSequence(impl, imageName, md, kind, args,
+			    rng);
+			file << segmentsLog;
+			sequenceFile << sequenceLog;
+
+			if (!file || !sequenceFile)
+				throw std::runtime_error(std::to_string(
+				    getpid()) + ": Error writing to log");
+		}
+		return;
+	}
+
+	if (args.bandRows > 0) {
+		auto streamFile = openLog("segments_stream", kind,
+		    STREAM_LOG_HEADER);
+		for (const auto &imageName : keys) {
+			const auto md = VALIDATION_DATA.at(kind).at(imageName);
+			const auto [segmentsLog, streamLog] = segmentStream(
+			    impl, imageName, md, kind, args);
+			file << segmentsLog;
+			streamFile << streamLog;
+
+			if (!file || !streamFile)
+				throw std::runtime_error(std::to_string(
+				    getpid()) + ": Error writing to log");
+		}
+		return;
+	}
+
+	if (args.reuseOutput) {
+		/* One output buffer for every call this worker makes */
+		CompactSegmentationPositions positions{};
+		for (const auto &imageName : keys) {
+			const auto md = VALIDATION_DATA.at(kind).at(imageName);
+			file << segmentCompact(impl, imageName, md, kind,
+			    positions);
+
+			if (!file)
+				throw std::runtime_error(std::to_string(
+				    getpid()) + ": Error writing to log");
+		}
+		return;
+	}
 
-		if (!file)
+	std::ofstream budgetFile{};
+	if (args.latencyBudget.count() > 0)
+		budgetFile = openLog("segments_budget", kind,
+		    BUDGET_LOG_HEADER);
+
+	/* Read the next images while the current one is segmented */
+	std::unique_ptr<ImagePrefetcher> prefetcher{};
+	if (args.prefetchDepth > 0)
+		prefetcher = std::make_unique<ImagePrefetcher>(kind, keys,
+		    args.prefetchDepth, args.rowPadding);
+
+	const auto write = [&](const std::tuple<std::string, std::string>
+	    &logs) {
+		file << std::get<0>(logs);
+		if (args.latencyBudget.count() > 0)
+			budgetFile << std::get<1>(logs);
+
+		if (!file || !budgetFile)
+			throw std::runtime_error(std::to_string(getpid()) +
+			    ": Error writing to log");
+	};
+
+	std::size_t numImages{0};
+	if (prefetcher) {
+		while (const auto next = prefetcher->next()) {
+			const auto &[imageName, image] = *next;
+			write(segment(impl, imageName, VALIDATION_DATA.at(
+			    kind).at(imageName), image, args));
+			++numImages;
+		}
+	} else {
+		for (const auto &imageName : keys)
+			write(segment(impl, imageName, VALIDATION_DATA.at(
+			    kind).at(imageName), kind, args));
+	}
+
+	if (prefetcher) {
+		auto prefetchFile = openLog("prefetch", kind,
+		    PREFETCH_LOG_HEADER);
+		prefetchFile << args.prefetchDepth << ',' << numImages <<
+		    ',' << prefetcher->getStarvedTime().count() << '\n';
+		if (!prefetchFile)
 			throw std::runtime_error(std::to_string(getpid()) +
 			    ": Error writing to log");
 	}
@@ -270,88 +1809,331 @@ void
 SlapSegIII::Validation::runDetermineOrientation(
     std::shared_ptr<Interface> impl,
     const SlapImage::Kind kind,
-    const std::vector<std::string> &keys)
+    WorkQueue &keys,
+    const Arguments &args)
 {
 	/* Don't run if implementation does not claim support */
 	if (!std::get<1>(impl->getSupported()))
 		return;
 
-	std::ofstream file("output/orientation-" + e2i2s(kind) + '-' +
-	    std::to_string(getpid()) + ".log");
-	if (!file) {
-		throw std::runtime_error(std::to_string(getpid()) + ": Error "
-		    "creating log file");
+	auto file = openLog("orientation", kind, ORIENTATION_LOG_HEADER);
+
+	if ((args.numOutstanding > 0) || (args.numThreads > 1)) {
+		TimedAsyncInterface async{impl, args.numThreads};
+		determineOrientationAsync(async, kind, keys,
+		    std::max(args.numOutstanding, args.numThreads), file);
+		return;
 	}
 
-	static const std::string header{"name,elapsed,rCode,\"rMessage\","
-	    "orientation"};
-	file << header << '\n';
-	if (!file)
-		throw std::runtime_error(std::to_string(getpid()) + ": Error "
-		    "writing to log");
+	std::ofstream budgetFile{};
+	if (args.latencyBudget.count() > 0)
+		budgetFile = openLog("orientation_budget", kind,
+		    BUDGET_LOG_HEADER);
 
 	for (const auto &imageName : keys) {
 		const auto md = VALIDATION_DATA.at(kind).at(imageName);
-		file << determineOrientation(impl, imageName, md, kind);
+		const auto [orientationLog, budgetLog] = determineOrientation(
+		    impl, imageName, md, kind, args);
+		file << orientationLog;
+		if (args.latencyBudget.count() > 0)
+			budgetFile << budgetLog;
+
+		if (!file || !budgetFile)
+			throw std::runtime_error(std::to_string(getpid()) +
+			    ": Error writing to log");
+	}
+}
+
+std::vector<SlapSegIII::Validation::WorkQueue::WorkerStatistics>
+SlapSegIII::Validation::runWorkers(
+    std::shared_ptr<Interface> impl,
+    const SlapImage::Kind kind,
+    const std::vector<std::string> &keys,
+    const uint16_t numProcs,
+    const Arguments &args)
+{
+	/* Workers claim images as they go, so none wait on others */
+	WorkQueue queue{keys, numProcs};
+
+	/* Each worker gets a CPU for each of its threads */
+	const auto placements = placeWorkers(getCPUTopology(), args.placement,
+	    args.bindNodes, numProcs, args.numThreads);
+	const auto statistics = [&]() {
+		auto workers = queue.getWorkerStatistics();
+		for (std::size_t i{0}; i < workers.size(); ++i)
+			workers[i].placement = placements.at(i);
+		return (workers);
+	};
+
+	if (numProcs <= 1) {
+		const WorkerPlacement unpinned{getAffinity(), -1};
+		applyPlacement(placements.front());
+		runOperation(impl, kind, queue, args);
+		queue.finish();
+		if (!placements.front().cpus.empty())
+			setAffinity(unpinned.cpus);
+		if (placements.front().node >= 0)
+			setMemoryNode(unpinned.node);
+		return (statistics());
+	}
+
+	/* Fork. */
+	for (uint16_t worker{0}; worker < numProcs; ++worker) {
+		impl->preFork();
+		const auto pid = fork();
+		switch (pid) {
+		case 0:		/* Child */
+			try {
+				/* Before postForkChild() starts threads or
+				 * the worker touches its buffers */
+				applyPlacement(placements.at(worker));
+				impl->postForkChild();
+				queue.setWorker(worker);
+				runOperation(impl, kind, queue, args);
+				queue.finish();
+			} catch (const std::exception &e) {
+				std::cerr << e.what() << '\n';
+				std::exit(1);
+			} catch (...) {
+				std::cerr << "Caught unknown exception\n";
+				std::exit(1);
+			}
+			std::exit(0);
+
+			/* Not reached */
+			break;
+		case -1:	/* Error */
+			impl->postForkParent();
+			throw std::runtime_error("Error during fork()");
+		default:	/* Parent */
+			impl->postForkParent();
+			break;
+		}
+	}
+
+	waitForExit(numProcs);
+	return (statistics());
+}
+
+std::string
+SlapSegIII::Validation::sanitizeMessage(
+    const std::string &message)
+{
+	if (message.empty())
+		return {"\"\""};
+
+	std::string sanitized{message};
+
+	/* Replace characters not matching the documented regex with space */
+	auto it = sanitized.begin();
+	while ((it = std::find_if_not(sanitized.begin(), sanitized.end(),
+	    [](const char &c) -> bool {
+		return (std::isgraph(c) || c == ' ');
+	    })) != sanitized.end()) {
+		sanitized.replace(it, std::next(it), " ");
+	}
+
+	/* Replace " with \" (we log to quoted CSV columns) */
+	static const std::string from{"\""};
+	static const std::string to{"\\\""};
+	std::string::size_type position{0};
+	while ((position = sanitized.find(from, position)) !=
+	    std::string::npos) {
+		sanitized.replace(position, from.length(), to);
+		position += to.length();
+	}
+	return ('"' + sanitized + '"');
+}
+
+std::tuple<std::string, std::string>
+SlapSegIII::Validation::segment(
+    const std::shared_ptr<Interface> impl,
+    const std::string &imageName,
+    const Validation::ImageMetadata &md,
+    const SlapImage::Kind kind,
+    const Arguments &args)
+{
+	return (segment(impl, imageName, md, readImage(imageName, md, kind,
+	    md.orientation, args.rowPadding), args));
+}
+
+std::tuple<std::string, std::string>
+SlapSegIII::Validation::segment(
+    const std::shared_ptr<Interface> impl,
+    const std::string &imageName,
+    const Validation::ImageMetadata &md,
+    const SlapImage &si,
+    const Arguments &args)
+{
+	const auto latencyBudget = args.latencyBudget;
+
+	std::tuple<ReturnStatus, std::vector<SegmentationPosition>> rv{};
+	std::chrono::steady_clock::time_point start{}, stop{};
+	try {
+		start = std::chrono::steady_clock::now();
+		if (latencyBudget.count() > 0)
+			rv = impl->segmentWithCancellation(si,
+			    CancellationToken{start + latencyBudget});
+		else
+			rv = impl->segment(si);
+		stop = std::chrono::steady_clock::now();
+	} catch (const std::exception &e) {
+		throw std::runtime_error("Exception while segmenting " +
+		    imageName + " (" + e.what() + ")");
+	} catch (...) {
+		throw std::runtime_error("Exception while segmenting " +
+		    imageName);
+	}
+
+	const auto elapsed = std::chrono::duration_cast<
+	    std::chrono::microseconds>(stop - start);
+	recordLatency({si.kind, md.ppi, md.captureTechnology}, elapsed);
+	return (std::make_tuple(formatSegmentation(imageName, md, si, rv,
+	    elapsed), latencyBudget.count() > 0 ? formatBudget(imageName,
+	    elapsed, latencyBudget, std::get<0>(rv).code) : std::string{}));
+}
+
+void
+SlapSegIII::Validation::segmentAsync(
+    TimedAsyncInterface &async,
+    const SlapImage::Kind kind,
+    WorkQueue &keys,
+    const uint16_t numOutstanding,
+    std::ostream &log)
+{
+	struct Pending
+	{
+		std::string imageName{};
+		std::future<TimedAsyncInterface::Result<std::tuple<
+		    ReturnStatus, std::vector<SegmentationPosition>>>>
+		    result{};
+	};
+	std::deque<Pending> pending{};
+
+	const auto complete = [&]() {
+		auto &p = pending.front();
+		const auto result = p.result.get();
+
+		const auto &md = VALIDATION_DATA.at(kind).at(p.imageName);
+		recordLatency({kind, md.ppi, md.captureTechnology},
+		    result.elapsed);
+		log << formatSegmentation(p.imageName, md, result.image,
+		    result.value, result.elapsed);
+		if (!log)
+			throw std::runtime_error(std::to_string(getpid()) +
+			    ": Error writing to log");
+		pending.pop_front();
+	};
+
+	for (const auto &imageName : keys) {
+		pending.push_back({imageName, async.segment(imageName, kind)});
+		while (pending.size() >= numOutstanding)
+			complete();
+	}
+	while (!pending.empty())
+		complete();
+}
+
+std::tuple<std::string, std::string>
+SlapSegIII::Validation::segmentAndDetermineOrientation(
+    const std::shared_ptr<Interface> impl,
+    const std::string &imageName,
+    const Validation::ImageMetadata &md,
+    const SlapImage::Kind kind)
+{
+	const auto si = readImage(imageName, md, kind,
+	    SlapImage::Orientation{}, 0);
 
-		if (!file)
-			throw std::runtime_error(std::to_string(getpid()) +
-			    ": Error writing to log");
+	std::tuple<std::tuple<ReturnStatus, std::vector<SegmentationPosition>>,
+	    std::tuple<ReturnStatus, SlapImage::Orientation>> rv{};
+	std::chrono::steady_clock::time_point start{}, stop{};
+	try {
+		start = std::chrono::steady_clock::now();
+		rv = impl->segmentAndDetermineOrientation(si);
+		stop = std::chrono::steady_clock::now();
+	} catch (const std::exception &e) {
+		throw std::runtime_error("Exception while segmenting and "
+		    "determining orientation of " + imageName + " (" +
+		    e.what() + ")");
+	} catch (...) {
+		throw std::runtime_error("Exception while segmenting and "
+		    "determining orientation of " + imageName);
 	}
+
+	const auto elapsed = std::chrono::duration_cast<
+	    std::chrono::microseconds>(stop - start);
+	recordLatency({kind, md.ppi, md.captureTechnology}, elapsed);
+	return (std::make_tuple(
+	    formatSegmentation(imageName, md, si, std::get<0>(rv), elapsed),
+	    formatOrientation(imageName, std::get<1>(rv), elapsed)));
 }
 
 std::string
-SlapSegIII::Validation::sanitizeMessage(
-    const std::string &message)
+SlapSegIII::Validation::segmentBatch(
+    const std::shared_ptr<Interface> impl,
+    const std::span<const std::string> imageNames,
+    const SlapImage::Kind kind)
 {
-	if (message.empty())
-		return {"\"\""};
-
-	std::string sanitized{message};
+	std::vector<SlapImage> images{};
+	images.reserve(imageNames.size());
+	for (const auto &imageName : imageNames) {
+		const auto md = VALIDATION_DATA.at(kind).at(imageName);
+		images.push_back(readImage(imageName, md, kind,
+		    md.orientation, 0));
+	}
 
-	/* Replace characters not matching the documented regex with space */
-	auto it = sanitized.begin();
-	while ((it = std::find_if_not(sanitized.begin(), sanitized.end(),
-	    [](const char &c) -> bool {
-		return (std::isgraph(c) || c == ' ');
-	    })) != sanitized.end()) {
-		sanitized.replace(it, std::next(it), " ");
+	std::vector<std::tuple<ReturnStatus,
+	    std::vector<SegmentationPosition>>> rv{};
+	std::chrono::steady_clock::time_point start{}, stop{};
+	try {
+		start = std::chrono::steady_clock::now();
+		rv = impl->segmentBatch(images);
+		stop = std::chrono::steady_clock::now();
+	} catch (const std::exception &e) {
+		throw std::runtime_error("Exception while segmenting batch "
+		    "starting with " + imageNames.front() + " (" + e.what() +
+		    ")");
+	} catch (...) {
+		throw std::runtime_error("Exception while segmenting batch "
+		    "starting with " + imageNames.front());
 	}
 
-	/* Replace " with \" (we log to quoted CSV columns) */
-	static const std::string from{"\""};
-	static const std::string to{"\\\""};
-	std::string::size_type position{0};
-	while ((position = sanitized.find(from, position)) !=
-	    std::string::npos) {
-		sanitized.replace(position, from.length(), to);
-		position += to.length();
+	if (rv.size() != images.size())
+		throw std::runtime_error("Batch starting with " +
+		    imageNames.front() + " returned " + ts(rv.size()) +
+		    " results for " + ts(images.size()) + " images");
+
+	/* Attribute an equal share of the batch's time to each image */
+	const auto elapsed = std::chrono::duration_cast<
+	    std::chrono::microseconds>(stop - start) /
+	    static_cast<std::chrono::microseconds::rep>(images.size());
+
+	std::string logLines{};
+	for (decltype(images)::size_type i{0}; i < images.size(); ++i) {
+		const auto &md = VALIDATION_DATA.at(kind).at(imageNames[i]);
+		recordLatency({kind, md.ppi, md.captureTechnology}, elapsed);
+		logLines += formatSegmentation(imageNames[i], md, images[i],
+		    rv[i], elapsed);
 	}
-	return ('"' + sanitized + '"');
+
+	return (logLines);
 }
 
 std::string
-SlapSegIII::Validation::segment(
+SlapSegIII::Validation::segmentCompact(
     const std::shared_ptr<Interface> impl,
     const std::string &imageName,
     const Validation::ImageMetadata &md,
-    const SlapImage::Kind kind)
+    const SlapImage::Kind kind,
+    CompactSegmentationPositions &positions)
 {
-	std::shared_ptr<SlapImage> si;
-	try {
-		si = std::make_shared<SlapImage>(md.width, md.height, md.ppi,
-		    kind, md.captureTechnology, md.orientation,
-		    readFile(IMAGE_DIR + '/' + imageName));
-	} catch (const std::exception &e) {
-		throw std::runtime_error("Error reading " + imageName + " (" +
-		    e.what() + ")");
-	}
+	const auto si = readImage(imageName, md, kind, md.orientation, 0);
 
-	std::tuple<ReturnStatus, std::vector<SegmentationPosition>> rv{};
+	CompactReturnStatus status{};
 	std::chrono::steady_clock::time_point start{}, stop{};
 	try {
 		start = std::chrono::steady_clock::now();
-		rv = impl->segment(*si.get());
+		status = impl->segmentInto(si, positions);
 		stop = std::chrono::steady_clock::now();
 	} catch (const std::exception &e) {
 		throw std::runtime_error("Exception while segmenting " +
@@ -361,145 +2143,144 @@ SlapSegIII::Validation::segment(
 		    imageName);
 	}
 
-	/* Enforce correct reporting of image deficiencies */
-	if (((std::get<0>(rv).code == ReturnStatus::Code::RequestRecapture) ||
-	    (std::get<0>(rv).code ==
-	    ReturnStatus::Code::RequestRecaptureWithAttempt)) &&
-	    (std::get<0>(rv).imageDeficiencies.size() == 0))
-		throw std::runtime_error("At least one image deficiency must "
-		    "be set if requesting recapture for image " + imageName);
-	if ((std::get<0>(rv).imageDeficiencies.size() != 0) &&
-	    (std::get<0>(rv).code != ReturnStatus::Code::RequestRecapture) &&
-	    (std::get<0>(rv).code !=
-	    ReturnStatus::Code::RequestRecaptureWithAttempt))
-		throw std::runtime_error("Cannot declare an image deficiency "
-		    "if not requesting a recapture for image " + imageName);
+	/* Convert outside of timing, only to reuse the log formatter */
+	const auto elapsed = std::chrono::duration_cast<
+	    std::chrono::microseconds>(stop - start);
+	recordLatency({kind, md.ppi, md.captureTechnology}, elapsed);
+	return (formatSegmentation(imageName, md, si,
+	    std::make_tuple(status.toReturnStatus(),
+	    positions.toSegmentationPositions()), elapsed));
+}
 
-	const auto elapsed = std::to_string(std::chrono::duration_cast<
-	    std::chrono::microseconds>(stop - start).count());
+std::tuple<std::string, std::string>
+SlapSegIII::Validation::segmentSequence(
+    const std::shared_ptr<Interface> impl,
+    const std::string &imageName,
+    const Validation::ImageMetadata &md,
+    const SlapImage::Kind kind,
+    const Arguments &args,
+    std::mt19937_64 &rng)
+{
+	const auto si = readImage(imageName, md, kind, md.orientation, 0);
 
-	std::string logLine{};
-	/* Record all information for successful ReturnStatus values */
-	if (std::get<0>(rv).code == ReturnStatus::Code::Success ||
-	    std::get<0>(rv).code ==
-	    ReturnStatus::Code::RequestRecaptureWithAttempt) {
-		const auto correctQuantity = std::to_string(
-		    Validate::hasCorrectQuantity(std::get<1>(rv),
-		    md.orientation));
+	/* Small movements and lighting changes between frames */
+	std::uniform_int_distribution<int16_t> shift(-4, 4);
+	std::uniform_int_distribution<int16_t> light(-3, 3);
 
-		/* Expected SegmentationPositions, but didn't set any */
-		if (std::get<1>(rv).size() == 0) {
-			for (const auto &frgp : Validate::
-			    getExpectedFrictionRidgeGeneralizedPositions(
-			    md.orientation))
-				logLine += imageName + ',' + elapsed + ',' +
-				    e2i2s(std::get<0>(rv).code) + ',' +
-				    sanitizeMessage(std::get<0>(rv).message) +
-				    ',' + e2i2s(frgp) + ",NA,NA,NA,NA,NA,NA,NA,"
-				    "NA,NA,\"ERROR: NIST entered this line on "
-				    "your behalf. You did not set any "
-				    "SegmentationPositions.\",\"\",\"\",0\n";
-		/* Record SegmentationPositions when Result is Success */
-		} else {
-			for (const auto &pos : std::get<1>(rv)) {
-				if (pos.result.code == SegmentationPosition::
-				    Result::Code::Success) {
-					logLine += imageName + ',' + elapsed +
-					    ',' + e2i2s(std::get<0>(rv).code) +
-					    ',' + sanitizeMessage(
-					    std::get<0>(rv).message) +
-					    ',' + e2i2s(pos.frgp) + ',' +
-					    ts(pos.tl.x) + ',' + ts(pos.tl.y) +
-					    ',' + ts(pos.tr.x) + ',' +
-					    ts(pos.tr.y) + ',' + ts(pos.bl.x) +
-					    ',' + ts(pos.bl.y) + ',' +
-					    ts(pos.br.x) + ',' + ts(pos.br.y) +
-					    ',' + e2i2s(pos.result.code) + ',' +
-					    sanitizeMessage(pos.result.
-					    message) + ",\"" + Validate::
-					    validateSegmentationPosition(pos,
-					    si).to_string() + "\",\"" +
-					    Validate::gatherDeficiencies(
-					    std::get<0>(rv)).to_string() +
-					    "\"," + correctQuantity + '\n';
-				} else {
-					logLine += imageName + ',' + elapsed +
-					    ',' +
-					    e2i2s(std::get<0>(rv).code) + ',' +
-					    sanitizeMessage(std::get<0>(rv).
-					    message) +
-					    ',' + e2i2s(pos.frgp) + ",NA,NA,NA,"
-					    "NA,NA,NA,NA,NA," + e2i2s(
-					    pos.result.code) + ',' +
-					    sanitizeMessage(pos.result.
-					    message) + ",\"" + Validate::
-					    validateSegmentationPosition(pos,
-					    si).to_string() + "\",\"" +
-					    Validate::gatherDeficiencies(
-					    std::get<0>(rv)).to_string() +
-					    "\"," + correctQuantity + '\n';
-				}
+	std::string sequenceLog{};
+	std::string segmentsLog{};
+	try {
+		auto session = impl->beginSession();
+		for (uint16_t frame{0}; frame < args.numFrames; ++frame) {
+			const bool last{frame == (args.numFrames - 1)};
+			const int16_t dx{last ? int16_t{0} : shift(rng)};
+			const int16_t dy{last ? int16_t{0} : shift(rng)};
+			const auto jittered = last ? SlapImage{} :
+			    jitterImage(si, dx, dy, light(rng));
+
+			const auto start = std::chrono::steady_clock::now();
+			const auto rv = session->segmentFrame(last ? si :
+			    jittered);
+			const auto elapsed = std::chrono::duration_cast<
+			    std::chrono::microseconds>(
+			    std::chrono::steady_clock::now() - start);
+
+			sequenceLog += imageName + ',' + ts(frame) + ',' +
+			    std::to_string(dx) + ',' + std::to_string(dy) +
+			    ',' + ts(elapsed.count()) + ',' +
+			    e2i2s(std::get<0>(rv).code) + '\n';
+			if (last) {
+				recordLatency({kind, md.ppi,
+				    md.captureTechnology}, elapsed);
+				segmentsLog = formatSegmentation(imageName, md,
+				    si, rv, elapsed);
 			}
 		}
-	/* Don't record SegmentationPositions, but do record Deficiency */
-	} else if (std::get<0>(rv).code ==
-	    ReturnStatus::Code::RequestRecapture) {
-		for (const auto &frgp :
-		    Validate::getExpectedFrictionRidgeGeneralizedPositions(
-		    md.orientation))
-			logLine += imageName + ',' + elapsed + ',' +
-			    e2i2s(std::get<0>(rv).code) + ',' +
-			    sanitizeMessage(std::get<0>(rv).message) + ',' +
-			    e2i2s(frgp) + ",NA,NA,NA,NA,NA,NA,NA,NA,NA,\"\","
-			    "\"\"," + Validate::gatherDeficiencies(std::get<0>(
-			    rv)).to_string() + ",1\n";
-	/* Only record ReturnStatus information */
-	} else {
-		for (const auto &frgp :
-		    Validate::getExpectedFrictionRidgeGeneralizedPositions(
-		    md.orientation))
-			logLine += imageName + ',' + elapsed + ',' +
-			    e2i2s(std::get<0>(rv).code) + ',' +
-			    sanitizeMessage(std::get<0>(rv).message) + ',' +
-			    e2i2s(frgp) + ",NA,NA,NA,NA,NA,NA,NA,NA,NA,\"\","
-			    "\"\",\"\",1\n";
+	} catch (const std::exception &e) {
+		throw std::runtime_error("Exception while segmenting sequence "
+		    "of " + imageName + " (" + e.what() + ")");
+	} catch (...) {
+		throw std::runtime_error("Exception while segmenting sequence "
+		    "of " + imageName);
 	}
 
-	return (logLine);
+	return (std::make_tuple(segmentsLog, sequenceLog));
 }
 
-std::vector<std::vector<std::string>>
-SlapSegIII::Validation::splitSet(
-    const std::vector<std::string> &combinedSet,
-    uint8_t numSets)
+std::tuple<std::string, std::string>
+SlapSegIII::Validation::segmentStream(
+    const std::shared_ptr<Interface> impl,
+    const std::string &imageName,
+    const Validation::ImageMetadata &md,
+    const SlapImage::Kind kind,
+    const Arguments &args)
 {
-	if (numSets == 0)
-		return {};
-	if (numSets == 1)
-		return {combinedSet};
+	const auto si = readImage(imageName, md, kind, md.orientation, 0);
+	const auto pixels = si.getPixels();
+	const std::size_t bandBytes{static_cast<std::size_t>(args.bandRows) *
+	    si.width};
+	const SlapImage metadata{si.width, si.height, si.ppi, si.kind,
+	    si.captureTechnology, si.orientation, std::vector<std::byte>{}};
 
-	using diff_t = decltype(combinedSet.begin())::difference_type;
-	if (combinedSet.size() >
-	    static_cast<uint64_t>(std::numeric_limits<diff_t>::max()))
-		return {combinedSet};
+	std::tuple<ReturnStatus, std::vector<SegmentationPosition>> rv{};
+	std::chrono::steady_clock::time_point lastPushed{}, stop{};
+	std::chrono::microseconds pushTime{0};
+	uint64_t numBands{0};
+	try {
+		auto stream = impl->beginSegmentation(metadata);
+
+		const auto start = std::chrono::steady_clock::now();
+		std::size_t offset{0};
+		while (offset < pixels.size()) {
+			/* Wait for the scanner to deliver the next band */
+			std::this_thread::sleep_until(start +
+			    (args.bandInterval * static_cast<
+			    std::chrono::milliseconds::rep>(numBands)));
+
+			const auto band = pixels.subspan(offset, std::min(
+			    bandBytes, pixels.size() - offset));
+			const auto pushStart = std::chrono::steady_clock::now();
+			const auto status = stream->pushRows(band);
+			lastPushed = std::chrono::steady_clock::now();
+			pushTime += std::chrono::duration_cast<
+			    std::chrono::microseconds>(lastPushed - pushStart);
+
+			offset += band.size();
+			++numBands;
+			if (status.code != ReturnStatus::Code::Success)
+				break;
+		}
+
+		rv = stream->finish();
+		stop = std::chrono::steady_clock::now();
+	} catch (const std::exception &e) {
+		throw std::runtime_error("Exception while streaming " +
+		    imageName + " (" + e.what() + ")");
+	} catch (...) {
+		throw std::runtime_error("Exception while streaming " +
+		    imageName);
+	}
 
-	const std::vector<std::string>::size_type size{static_cast<
-	    std::vector<std::string>::size_type>(
-	    std::ceil(static_cast<float>(combinedSet.size()) /
-	    static_cast<float>(numSets)))};
-	if (size < numSets)
-		throw std::invalid_argument("Too many sets.");
+	const auto elapsed = std::chrono::duration_cast<
+	    std::chrono::microseconds>(stop - lastPushed);
+	recordLatency({kind, md.ppi, md.captureTechnology}, elapsed);
+	return (std::make_tuple(formatSegmentation(imageName, md, si, rv,
+	    elapsed), imageName + ',' + ts(numBands) + ',' +
+	    ts(pushTime.count()) + ',' + ts(elapsed.count()) + '\n'));
+}
 
-	std::vector<std::vector<std::string>> sets{};
-	sets.reserve(numSets);
-	for (uint8_t i{0}; i < numSets; ++i)
-		sets.emplace_back(std::next(combinedSet.begin(),
-		    static_cast<diff_t>(size * i)),
-		    std::next(combinedSet.begin(),
-		    static_cast<diff_t>(std::min(size * (i + 1u),
-		    combinedSet.size()))));
+void
+SlapSegIII::Validation::setLogDirectory(
+    const std::filesystem::path &directory)
+{
+	logDirectory = directory;
+}
 
-	return (sets);
+void
+SlapSegIII::Validation::setPixelViews(
+    const bool enabled)
+{
+	pixelViews = enabled;
 }
 
 void
@@ -507,10 +2288,101 @@ SlapSegIII::Validation::testOperation(
     const Validation::Arguments &args)
 {
         auto rng = std::mt19937_64(args.randomSeed);
+	setIOBackend(args.ioBackend, args.evictBeforeRead);
 
+	const auto coldStart = std::chrono::steady_clock::now();
 	const auto impl = SlapSegIII::Interface::getImplementation(
 	    args.configDir);
+	const auto coldStop = std::chrono::steady_clock::now();
 	const auto kinds = std::get<0>(impl->getSupported());
+	const bool viewsSupported{impl->supportsPixelViews()};
+	setPixelViews(viewsSupported);
+
+	/* Before fork(), so children share prepared memory */
+	ReturnStatus prepared{};
+	std::chrono::steady_clock::time_point prepareStart{}, prepareStop{};
+	try {
+		prepareStart = std::chrono::steady_clock::now();
+		prepared = impl->prepare(kinds);
+		prepareStop = std::chrono::steady_clock::now();
+	} catch (const std::exception &e) {
+		throw std::runtime_error("Exception while preparing (" +
+		    std::string(e.what()) + ")");
+	} catch (...) {
+		throw std::runtime_error("Exception while preparing");
+	}
+
+	if (args.verbose) {
+		auto startupFile = openLog("startup", STARTUP_LOG_HEADER);
+		startupFile << ts(std::chrono::duration_cast<
+		    std::chrono::microseconds>(coldStop - coldStart).
+		    count()) << ',' << ts(std::chrono::duration_cast<
+		    std::chrono::microseconds>(prepareStop - prepareStart).
+		    count()) << ',' << e2i2s(prepared.code) << ',' <<
+		    sanitizeMessage(prepared.message) << '\n';
+		startupFile.close();
+		if (!startupFile)
+			throw std::runtime_error(std::to_string(getpid()) +
+			    ": Error writing to log");
+	}
+	if (prepared.code != ReturnStatus::Code::Success)
+		throw std::runtime_error("prepare() returned " +
+		    e2i2s(prepared.code) + " (" + prepared.message + ")");
+
+	/* Record the CPUs that workers were sized against */
+	const auto cpus = getCPUBudget();
+	if (args.verbose) {
+		auto cpuFile = openLog("cpu", CPU_LOG_HEADER);
+		cpuFile << ts(cpus.online) << ',' << ts(cpus.affinity) << ',';
+		if (cpus.quota > 0)
+			cpuFile << cpus.quota;
+		else
+			cpuFile << "max";
+		cpuFile << ',' << ts(cpus.budget) << '\n';
+		cpuFile.close();
+		if (!cpuFile)
+			throw std::runtime_error(std::to_string(getpid()) +
+			    ": Error writing to log");
+	}
+
+	/* Threads share impl, so it must allow concurrent calls */
+	if (args.numThreads > 1) {
+		const auto capabilities = impl->getConcurrencyCapabilities();
+		if (!capabilities.reentrant)
+			throw std::runtime_error("Number of threads (-t): "
+			    "implementation is not reentrant");
+		if ((capabilities.maxConcurrentCalls != 0) &&
+		    (args.numThreads > capabilities.maxConcurrentCalls))
+			throw std::runtime_error("Number of threads (-t): "
+			    "implementation allows at most " +
+			    ts(capabilities.maxConcurrentCalls) + " "
+			    "concurrent calls");
+	}
+
+	/* Choose processes and threads from declared capabilities */
+	Arguments runArgs{args};
+	if (args.autoWorkers) {
+		auto capabilities = impl->getConcurrencyCapabilities();
+		if (requiresSynchronousCalls(args))
+			capabilities.reentrant = false;
+		std::tie(runArgs.numProcs, runArgs.numThreads) = planWorkers(
+		    capabilities, cpus.budget);
+	}
+
+	/* Latencies from every worker, merged in shared memory */
+	std::shared_ptr<LatencyHistograms> histograms{};
+	if (args.verbose) {
+		std::vector<LatencyKey> latencyKeys{};
+		for (const auto &kind : kinds)
+			for (const auto &[name, md] : VALIDATION_DATA.at(kind))
+				latencyKeys.push_back({kind, md.ppi,
+				    md.captureTechnology});
+		histograms = std::make_shared<LatencyHistograms>(latencyKeys);
+		setLatencyHistograms(histograms);
+	}
+	std::map<SlapImage::Kind, std::chrono::steady_clock::duration>
+	    kindElapsed{};
+
 	for (const auto &kind : kinds) {
 		/* Shuffle images of each Kind */
 		std::vector<std::string> imageNames{};
@@ -519,76 +2391,260 @@ SlapSegIII::Validation::testOperation(
 			imageNames.push_back(i.first);
 		std::shuffle(imageNames.begin(), imageNames.end(), rng);
 
-		if (args.numProcs <= 1) {
-			switch (args.operation) {
-			case Operation::Segment:
-				runSegment(impl, kind, imageNames);
-				break;
-			case Operation::Orientation:
-				runDetermineOrientation(impl, kind, imageNames);
-				break;
-			default:
-				throw std::runtime_error("Invalid operation "
-				    "sent to testOperation()");
-			}
+		/* Read every image once, before workers start timing */
+		if (args.sharedCorpus) {
+			std::vector<std::string> pathNames{};
+			pathNames.reserve(imageNames.size());
+			for (const auto &name : imageNames)
+				pathNames.push_back(IMAGE_DIR + '/' + name);
+
+			const auto corpusStart = std::chrono::steady_clock::
+			    now();
+			const auto corpus = std::make_shared<
+			    const ImageCorpus>(pathNames);
+			const auto corpusStop = std::chrono::steady_clock::
+			    now();
+			setImageCorpus(corpus);
+
+			auto corpusFile = openLog("corpus", kind,
+			    CORPUS_LOG_HEADER);
+			corpusFile << pathNames.size() << ',' <<
+			    corpus->size() << ',' << std::chrono::
+			    duration_cast<std::chrono::microseconds>(
+			    corpusStop - corpusStart).count() << ',' <<
+			    viewsSupported << '\n';
+			if (!corpusFile)
+				throw std::runtime_error(std::to_string(
+				    getpid()) + ": Error writing to log");
+		}
+
+		/* Don't start more processes than memory allows */
+		const auto availableMemory = getAvailableMemory();
+		const uint16_t requestedProcs{args.compareModes ?
+		    runArgs.numThreads : runArgs.numProcs};
+		const auto numProcs = limitProcsByMemory(requestedProcs,
+		    args.compareModes ? uint16_t{1} : runArgs.numThreads,
+		    getKindRequirements(impl, kind), availableMemory);
+		if (numProcs < requestedProcs)
+			logMemoryLimit(kind, requestedProcs, numProcs,
+			    availableMemory, !args.autoWorkers);
+
+		const auto runStart = std::chrono::steady_clock::now();
+		if (args.compareModes) {
+			compareModes(impl, kind, imageNames, numProcs, runArgs);
+			kindElapsed[kind] = std::chrono::steady_clock::now() -
+			    runStart;
 		} else {
-			/* Split into multiple sets of images */
-			const auto sets = splitSet(imageNames, args.numProcs);
-
-			/* Fork. */
-			for (const auto &set : sets) {
-				const auto pid = fork();
-				switch (pid) {
-				case 0:		/* Child */
-					try {
-						switch (args.operation) {
-						case Operation::Segment:
-							runSegment(impl, kind,
-							    set);
-							break;
-						case Operation::Orientation:
-							runDetermineOrientation(
-							    impl, kind, set);
-							break;
-						default:
-							throw std::
-							    runtime_error(
-							    "Invalid operation "
-							    "sent to test"
-							    "Operation()");
-						}
-					} catch (const std::exception &e) {
-						std::cerr << e.what() << '\n';
-						std::exit(1);
-					} catch (...) {
-						std::cerr << "Caught unknown "
-						    "exception\n";
-						std::exit(1);
-					}
-					std::exit(0);
-
-					/* Not reached */
-					break;
-				case -1:	/* Error */
-					throw std::runtime_error("Error during "
-					    "fork()");
-				default:	/* Parent */
-					break;
+			const auto workers = runWorkers(impl, kind, imageNames,
+			    numProcs, runArgs);
+			kindElapsed[kind] = std::chrono::steady_clock::now() -
+			    runStart;
+
+			if (args.verbose)
+				logWorkers(kind, workers);
+			if (args.bindNodes)
+				logNodeThroughput(kind, workers);
+		}
+
+		/* Release this kind's images before reading the next */
+		setImageCorpus(nullptr);
+	}
+
+	if (histograms != nullptr) {
+		setLatencyHistograms(nullptr);
+		writeLatencySummary(*histograms, kindElapsed);
+	}
+}
+
+void
+SlapSegIII::Validation::testPlugins(
+    const Validation::Arguments &args)
+{
+	auto rng = std::mt19937_64(args.randomSeed);
+	setIOBackend(args.ioBackend, args.evictBeforeRead);
+
+	std::vector<std::unique_ptr<Plugin>> plugins{};
+	std::vector<std::set<SlapImage::Kind>> supported{};
+	std::set<SlapImage::Kind> kinds{};
+	plugins.reserve(args.plugins.size());
+	for (const auto &[path, configDir] : args.plugins) {
+		plugins.push_back(std::make_unique<Plugin>(path, configDir));
+		try {
+			supported.push_back(
+			    plugins.back()->getSupportedKinds());
+		} catch (const std::exception &e) {
+			throw std::runtime_error("Exception while loading " +
+			    path.string() + " (" + e.what() + ")");
+		} catch (...) {
+			throw std::runtime_error("Exception while loading " +
+			    path.string());
+		}
+		kinds.insert(supported.back().begin(), supported.back().end());
+	}
+
+	/* Images are shared, so only reference pixels if all can read them */
+	setPixelViews(std::all_of(plugins.cbegin(), plugins.cend(),
+	    [](const auto &plugin) { return (plugin->supportsPixelViews()); }));
+
+	/* Keep one-time costs of every library out of the timed calls */
+	for (std::size_t p{0}; p < plugins.size(); ++p) {
+		ReturnStatus prepared{};
+		try {
+			prepared = plugins[p]->prepare(supported[p]);
+		} catch (const std::exception &e) {
+			throw std::runtime_error("Exception while preparing " +
+			    plugins[p]->getName() + " (" + e.what() + ")");
+		} catch (...) {
+			throw std::runtime_error("Exception while preparing " +
+			    plugins[p]->getName());
+		}
+		if (prepared.code != ReturnStatus::Code::Success)
+			throw std::runtime_error(plugins[p]->getName() + ": "
+			    "prepare() returned " + e2i2s(prepared.code) +
+			    " (" + prepared.message + ")");
+	}
+
+	auto summaryFile = openLog("plugins", PLUGIN_LOG_HEADER);
+	for (const auto &kind : kinds) {
+		const auto &metadata = Validation::VALIDATION_DATA.at(kind);
+
+		/* Shuffle images of each Kind */
+		std::vector<std::string> imageNames{};
+		imageNames.reserve(metadata.size());
+		for (const auto &i : metadata)
+			imageNames.push_back(i.first);
+		std::shuffle(imageNames.begin(), imageNames.end(), rng);
+
+		/*
+		 * Read each image once for all libraries. Build every
+		 * pyramid level here, so isolated libraries only read them.
+		 */
+		resetIOStatistics();
+		std::vector<SlapImage> images{};
+		images.reserve(imageNames.size());
+		for (const auto &name : imageNames) {
+			const auto &md = metadata.at(name);
+			images.push_back(readImage(name, md, kind,
+			    md.orientation, 0));
+			uint8_t depth{0};
+			while (((md.width >> (depth + 1)) > 0) &&
+			    ((md.height >> (depth + 1)) > 0))
+				++depth;
+			images.back().getPyramidLevel(depth);
+		}
+
+		auto ioFile = openLog("io", kind, IO_LOG_HEADER);
+		ioFile << formatIOStatistics();
+		if (!ioFile)
+			throw std::runtime_error(std::to_string(getpid()) +
+			    ": Error writing to log");
+
+		for (std::size_t p{0}; p < plugins.size(); ++p) {
+			if (!supported[p].contains(kind))
+				continue;
+			const auto &plugin = plugins[p];
+
+			auto logFile = openLog("segments_" + plugin->getName(),
+			    kind, SEGMENTATION_LOG_HEADER);
+			CompactSegmentationPositions positions{};
+			std::chrono::microseconds total{0};
+			std::size_t numImages{0};
+			for (std::size_t i{0}; i < images.size(); ++i) {
+				CompactReturnStatus status{};
+				std::chrono::steady_clock::time_point start{},
+				    stop{};
+				try {
+					start = std::chrono::steady_clock::
+					    now();
+					status = plugin->segmentInto(
+					    images[i], positions);
+					stop = std::chrono::steady_clock::now();
+				} catch (const std::exception &e) {
+					throw std::runtime_error("Exception "
+					    "while segmenting " +
+					    imageNames[i] + " with " +
+					    plugin->getName() + " (" +
+					    e.what() + ")");
+				} catch (...) {
+					throw std::runtime_error("Exception "
+					    "while segmenting " +
+					    imageNames[i] + " with " +
+					    plugin->getName());
 				}
+
+				const auto elapsed = std::chrono::
+				    duration_cast<std::chrono::microseconds>(
+				    stop - start);
+				total += elapsed;
+				++numImages;
+
+				logFile << formatSegmentation(imageNames[i],
+				    metadata.at(imageNames[i]), images[i],
+				    std::make_tuple(status.toReturnStatus(),
+				    positions.toSegmentationPositions()),
+				    elapsed);
+				if (!logFile)
+					throw std::runtime_error(std::to_string(
+					    getpid()) + ": Error writing to "
+					    "log");
 			}
 
-			waitForExit(args.numProcs);
+			summaryFile << plugin->getName() << ',' <<
+			    plugin->isIsolated() << ',' << e2i2s(kind) <<
+			    ',' << numImages << ',' << total.count() << '\n';
+			if (!summaryFile)
+				throw std::runtime_error(std::to_string(
+				    getpid()) + ": Error writing to log");
 		}
 	}
 }
 
+void
+SlapSegIII::Validation::writeLatencySummary(
+    const LatencyHistograms &histograms,
+    const std::map<SlapImage::Kind, std::chrono::steady_clock::duration>
+    &kindElapsed)
+{
+	std::string summary{};
+	for (const auto &key : histograms.getKeys()) {
+		const auto latencies = histograms.summarize(key);
+		const auto elapsed = kindElapsed.find(key.kind);
+		if ((latencies.count == 0) || (elapsed == kindElapsed.end()))
+			continue;
+
+		/* Images of this key, while all of its kind's ran */
+		const auto seconds = std::chrono::duration<double>(
+		    elapsed->second).count();
+		std::ostringstream rate{};
+		rate << (seconds > 0 ? static_cast<double>(latencies.count) /
+		    seconds : 0.0);
+
+		summary += e2i2s(key.kind) + ',' + ts(key.ppi) + ',' +
+		    e2i2s(key.captureTechnology) + ',' +
+		    ts(latencies.count) + ',' + ts(latencies.p50.count()) +
+		    ',' + ts(latencies.p90.count()) + ',' +
+		    ts(latencies.p99.count()) + ',' +
+		    ts(latencies.p999.count()) + ',' +
+		    ts(latencies.max.count()) + ',' + rate.str() + '\n';
+	}
+
+	auto summaryFile = openLog("latency", LATENCY_LOG_HEADER);
+	summaryFile << summary;
+	summaryFile.close();
+	if (!summaryFile)
+		throw std::runtime_error(std::to_string(getpid()) +
+		    ": Error writing to log");
+
+	std::cout << LATENCY_LOG_HEADER << '\n' << summary;
+}
+
 void
 SlapSegIII::Validation::waitForExit(
-    const uint8_t numChildren)
+    const uint16_t numChildren)
 {
 	pid_t pid{-1};
 	bool stop{false};
-	uint8_t exitedChildren{0};
+	uint16_t exitedChildren{0};
 	int status{};
 	while (exitedChildren != numChildren) {
 		stop = false;
@@ -627,9 +2683,9 @@ main(
 	int rv = EXIT_FAILURE;
 
 	if (!((SlapSegIII::API_MAJOR_VERSION == 1) &&
-	    (SlapSegIII::API_MINOR_VERSION == 2))) {
+	    (SlapSegIII::API_MINOR_VERSION == 3))) {
 		std::cerr << "Incompatible API version encountered.\n "
-		    "- Validation: 1.2.*\n - Participant: " <<
+		    "- Validation: 1.3.*\n - Participant: " <<
 		    SlapSegIII::API_MAJOR_VERSION << '.' <<
 		    SlapSegIII::API_MINOR_VERSION << '.' <<
 		    SlapSegIII::API_PATCH_VERSION << '\n';
@@ -663,7 +2719,10 @@ main(
 		break;
 	case SlapSegIII::Validation::Operation::Segment:
 		try {
-			SlapSegIII::Validation::testOperation(args);
+			if (args.plugins.empty())
+				SlapSegIII::Validation::testOperation(args);
+			else
+				SlapSegIII::Validation::testPlugins(args);
 			rv = EXIT_SUCCESS;
 		} catch (const std::exception &e) {
 			std::cerr << "Interface::segment(): " <<
@@ -699,6 +2758,20 @@ main(
 			    "Non-standard exception\n";
 		}
 		break;
+	case SlapSegIII::Validation::Operation::SegmentAndOrientation:
+		try {
+			SlapSegIII::Validation::testOperation(args);
+			rv = EXIT_SUCCESS;
+		} catch (const std::exception &e) {
+			std::cerr << "Interface::"
+			    "segmentAndDetermineOrientation(): " <<
+			    e.what() << '\n';
+		} catch (...) {
+			std::cerr << "Interface::"
+			    "segmentAndDetermineOrientation(): "
+			    "Non-standard exception\n";
+		}
+		break;
 	case SlapSegIII::Validation::Operation::Usage:
 		SlapSegIII::Validation::printUsage(argv[0]);
 		rv = EXIT_SUCCESS;
@@ -11,14 +11,34 @@
 #ifndef SLAPSEGIII_VALIDATION_H_
 #define SLAPSEGIII_VALIDATION_H_
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <random>
+#include <span>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
 #include <slapsegiii.h>
 #include <slapsegiii_validation_data.h>
+#include <slapsegiii_validation_io.h>
+#include <slapsegiii_validation_latency.h>
+#include <slapsegiii_validation_topology.h>
 
 namespace SlapSegIII
 {
@@ -36,7 +56,73 @@ namespace SlapSegIII
 			/** Print usage */
 			Usage,
 			/** Determine orientation */
-			Orientation
+			Orientation,
+			/** Segment and determine orientation together */
+			SegmentAndOrientation
+		};
+
+		/** Header of segmentation log files. */
+		const std::string SEGMENTATION_LOG_HEADER{"name,elapsed,rCode,"
+		    "\"rMessage\",frgp,tlx,tly,trx,try,blx,bly,brx,bry,sCode,"
+		    "\"sMessage\",\"errors\",\"deficiencies\",correctQuantity"};
+		/** Header of orientation log files. */
+		const std::string ORIENTATION_LOG_HEADER{"name,elapsed,rCode,"
+		    "\"rMessage\",orientation"};
+		/** Header of startup log files. */
+		const std::string STARTUP_LOG_HEADER{"getImplementation,"
+		    "prepare,rCode,\"rMessage\""};
+		/** Header of first call log files. */
+		const std::string FIRST_CALL_LOG_HEADER{"name,elapsed,rCode"};
+		/** Header of memory log files (values in KiB). */
+		const std::string MEMORY_LOG_HEADER{"rss,pss,sharedClean,"
+		    "sharedDirty,privateClean,privateDirty"};
+		/** Header of streaming log files. */
+		const std::string STREAM_LOG_HEADER{"name,bands,push,"
+		    "lastRowToResult"};
+		/** Header of sequence log files. */
+		const std::string SEQUENCE_LOG_HEADER{"name,frame,dx,dy,"
+		    "elapsed,rCode"};
+		/** Header of latency budget log files. */
+		const std::string BUDGET_LOG_HEADER{"name,elapsed,budget,rCode,"
+		    "overBudget"};
+		/** Header of I/O log files (elapsed in microseconds). */
+		const std::string IO_LOG_HEADER{"backend,evict,files,bytes,"
+		    "elapsed,bytesPerSecond"};
+		/** Header of shared corpus log files. */
+		const std::string CORPUS_LOG_HEADER{"images,bytes,elapsed,"
+		    "shared"};
+		/** Header of memory limit log files (available in bytes). */
+		const std::string MEMORY_LIMIT_LOG_HEADER{"requested,allowed,"
+		    "available"};
+		/** Header of prefetch log files (starved in microseconds). */
+		const std::string PREFETCH_LOG_HEADER{"depth,images,starved"};
+		/** Header of worker log files (times in microseconds). */
+		const std::string WORKER_LOG_HEADER{"worker,images,elapsed,"
+		    "idle,\"cpus\",node"};
+		/** Header of NUMA node log files (elapsed in microseconds). */
+		const std::string NUMA_LOG_HEADER{"node,workers,images,elapsed,"
+		    "imagesPerSecond"};
+		/** Header of mode comparison log files. */
+		const std::string COMPARE_LOG_HEADER{"mode,processes,threads,"
+		    "elapsed"};
+		/** Header of CPU budget log files. */
+		const std::string CPU_LOG_HEADER{"online,affinity,quota,"
+		    "budget"};
+		/** Header of latency summary log files (in microseconds). */
+		const std::string LATENCY_LOG_HEADER{"kind,ppi,"
+		    "captureTechnology,count,p50,p90,p99,p99.9,max,"
+		    "imagesPerSecond"};
+		/** Header of plugin summary log files. */
+		const std::string PLUGIN_LOG_HEADER{"library,isolated,kind,"
+		    "images,elapsed"};
+
+		/** Core library to load at runtime. */
+		struct PluginArgument
+		{
+			/** Path to the core library. */
+			std::filesystem::path path{};
+			/** Configuration directory for the core library. */
+			std::filesystem::path configDir{};
 		};
 
 		/** Arguments passed on the command line */
@@ -48,13 +134,564 @@ namespace SlapSegIII
 			/** Operation to be performed. */
 			Operation operation{};
 			/** Number of processes to run. */
-			uint8_t numProcs{1};
+			uint16_t numProcs{1};
+			/**
+			 * Whether to choose the number of processes and
+			 * threads from the implementation's declared
+			 * concurrency capabilities.
+			 */
+			bool autoWorkers{false};
+			/**
+			 * Number of threads per process calling into the
+			 * implementation.
+			 */
+			uint16_t numThreads{1};
+			/** Number of images passed to each segmentBatch(). */
+			uint16_t batchSize{1};
+			/**
+			 * Number of asynchronous requests to keep in flight
+			 * (0 to make synchronous calls).
+			 */
+			uint16_t numOutstanding{0};
+			/**
+			 * Time each call may take before it is cancelled
+			 * (0 for no limit).
+			 */
+			std::chrono::milliseconds latencyBudget{0};
+			/**
+			 * Whether each worker passes the same output storage
+			 * to every call to segment().
+			 */
+			bool reuseOutput{false};
+			/**
+			 * Number of bytes of padding after each row of
+			 * images passed to the implementation (0 to pass
+			 * tightly packed images).
+			 */
+			uint16_t rowPadding{0};
+			/**
+			 * Number of rows in each band pushed to a
+			 * SegmentationStream (0 to call segment() with whole
+			 * images).
+			 */
+			uint16_t bandRows{0};
+			/** Time between the arrival of consecutive bands. */
+			std::chrono::milliseconds bandInterval{0};
+			/**
+			 * Number of frames of each image passed to a
+			 * SegmentationSession (0 to call segment() once per
+			 * image).
+			 */
+			uint16_t numFrames{0};
+			/**
+			 * Core libraries to load at runtime and run in turn
+			 * on the same images (empty to use the linked core
+			 * library). Those not given a configuration
+			 * directory use configDir.
+			 */
+			std::vector<PluginArgument> plugins{};
+			/** How images are read from disk. */
+			IOBackend ioBackend{IOBackend::Buffered};
+			/**
+			 * Whether to drop each image from the page cache
+			 * before reading it.
+			 */
+			bool evictBeforeRead{false};
+			/**
+			 * Whether to read all images of a kind into one
+			 * shared mapping before starting workers. Workers
+			 * reference the mapping only if the implementation
+			 * supports pixel views, and copy from it otherwise.
+			 */
+			bool sharedCorpus{false};
+			/**
+			 * Number of images to read ahead of synchronous
+			 * calls to segment() (0 to read each image just
+			 * before its call).
+			 */
+			uint16_t prefetchDepth{0};
+			/**
+			 * Whether to run each kind with single-threaded
+			 * processes and then with threads of one process.
+			 */
+			bool compareModes{false};
+			/** How worker processes are pinned to CPUs. */
+			Placement placement{Placement::None};
+			/**
+			 * Whether to bind each worker process, and the
+			 * memory it allocates, to a NUMA node.
+			 */
+			bool bindNodes{false};
+			/**
+			 * Whether to write diagnostic logs (startup, CPU,
+			 * first call, memory, I/O, workers, and latency)
+			 * and print the latency summary to stdout.
+			 */
+			bool verbose{false};
 			/** Path to configuration directory. */
 			std::filesystem::path configDir{};
 		};
 		/** Convenience definition for struct Arguments. */
 		using Arguments = struct Arguments;
 
+		/**
+		 * @brief
+		 * Memory resource handing out scratch memory from a
+		 * preallocated buffer.
+		 *
+		 * @details
+		 * Allocations advance through the buffer and are reclaimed
+		 * together once every allocation has been deallocated, as
+		 * happens at the end of each call into an implementation.
+		 * Requests that do not fit are passed to an upstream resource.
+		 */
+		class ScratchArena : public std::pmr::memory_resource
+		{
+		public:
+			/**
+			 * @brief
+			 * ScratchArena constructor.
+			 *
+			 * @param size
+			 * Number of bytes to preallocate.
+			 * @param upstream
+			 * Resource used when the buffer is exhausted.
+			 */
+			ScratchArena(
+			    const std::size_t size,
+			    std::pmr::memory_resource *upstream =
+			    std::pmr::new_delete_resource());
+
+		private:
+			void*
+			do_allocate(
+			    std::size_t bytes,
+			    std::size_t alignment)
+			    override;
+
+			void
+			do_deallocate(
+			    void *p,
+			    std::size_t bytes,
+			    std::size_t alignment)
+			    override;
+
+			bool
+			do_is_equal(
+			    const std::pmr::memory_resource &other)
+			    const
+			    noexcept
+			    override;
+
+			/** Preallocated memory */
+			std::vector<std::byte> buffer{};
+			/** First unused byte of buffer */
+			std::size_t offset{0};
+			/** Allocations from buffer not yet deallocated */
+			std::size_t liveAllocations{0};
+			/** Resource used when buffer is exhausted */
+			std::pmr::memory_resource *upstream{};
+		};
+
+		/**
+		 * @brief
+		 * Keys handed out one at a time to any number of workers.
+		 *
+		 * @details
+		 * The position of the next unclaimed key is an atomic
+		 * counter in shared memory, so processes forked after
+		 * construction claim keys from a single queue. Keys are
+		 * claimed in their original order, and each is claimed
+		 * exactly once. Iterating over a WorkQueue claims keys
+		 * until none remain.
+		 */
+		class WorkQueue
+		{
+		public:
+			/** Input iterator claiming one key per increment. */
+			class Iterator
+			{
+			public:
+				using iterator_category =
+				    std::input_iterator_tag;
+				using value_type = std::string;
+				using difference_type = std::ptrdiff_t;
+				using pointer = const std::string*;
+				using reference = const std::string&;
+
+				Iterator(
+				    WorkQueue *queue,
+				    const std::size_t index);
+
+				reference
+				operator*()
+				    const;
+
+				Iterator&
+				operator++();
+
+				bool
+				operator==(
+				    const Iterator &other)
+				    const
+				    noexcept;
+
+			private:
+				/** Queue claimed from */
+				WorkQueue *queue{};
+				/** Index of the key last claimed */
+				std::size_t index{};
+			};
+
+			/** Work recorded by one worker. */
+			struct WorkerStatistics
+			{
+				/** Number of keys claimed */
+				uint64_t claimed{0};
+				/** Time from construction until finish() */
+				std::chrono::steady_clock::duration elapsed{};
+				/** Where the worker ran, set by runWorkers() */
+				WorkerPlacement placement{};
+			};
+
+			/**
+			 * @brief
+			 * WorkQueue constructor.
+			 *
+			 * @param keys
+			 * Keys to hand out. Must outlive this object.
+			 * @param numWorkers
+			 * Number of workers that will claim keys.
+			 *
+			 * @throw runtime_error
+			 * Shared memory could not be mapped.
+			 */
+			WorkQueue(
+			    const std::vector<std::string> &keys,
+			    const uint16_t numWorkers);
+
+			WorkQueue(
+			    const WorkQueue&) = delete;
+			WorkQueue&
+			operator=(
+			    const WorkQueue&) = delete;
+
+			~WorkQueue();
+
+			/** @return Iterator at a newly claimed key. */
+			Iterator
+			begin();
+
+			/** @return Iterator past the last key. */
+			Iterator
+			end();
+
+			/**
+			 * @brief
+			 * Claim several consecutive keys.
+			 *
+			 * @param count
+			 * Maximum number of keys to claim.
+			 *
+			 * @return
+			 * Claimed keys, fewer than `count` near the end of
+			 * the queue and empty when none remain.
+			 */
+			std::span<const std::string>
+			claim(
+			    const std::size_t count);
+
+			/**
+			 * @brief
+			 * Claim a key without consuming it.
+			 *
+			 * @return
+			 * Key that the next claim from this process will
+			 * return (alone, regardless of count), or nullptr
+			 * when none remain.
+			 *
+			 * @note
+			 * Not thread-safe. Call before other threads of
+			 * this process claim keys.
+			 */
+			const std::string*
+			peek();
+
+			/** @return Every key, claimed or not. */
+			const std::vector<std::string>&
+			getKeys()
+			    const
+			    noexcept;
+
+			/**
+			 * @brief
+			 * Identify the worker claiming keys in this
+			 * process.
+			 *
+			 * @param worker
+			 * Index of the worker, less than `numWorkers`.
+			 */
+			void
+			setWorker(
+			    const uint16_t worker);
+
+			/** Record that this process's worker is done. */
+			void
+			finish();
+
+			/**
+			 * @return
+			 * Statistics of each worker, visible once workers
+			 * have called finish().
+			 */
+			std::vector<WorkerStatistics>
+			getWorkerStatistics()
+			    const;
+
+		private:
+			/** Per-worker counters in shared memory */
+			struct Worker
+			{
+				std::atomic<uint64_t> claimed{0};
+				std::atomic<int64_t> elapsed{0};
+			};
+
+			/**
+			 * @return
+			 * Index of the first claimed key, and number of keys
+			 * claimed (at most `count`).
+			 */
+			std::tuple<std::size_t, std::size_t>
+			claimIndex(
+			    const std::size_t count);
+
+			/** Keys to hand out */
+			const std::vector<std::string> &keys;
+			/** Number of workers */
+			const uint16_t numWorkers;
+			/** Worker claiming keys in this process */
+			uint16_t worker{0};
+			/** When keys started being handed out */
+			const std::chrono::steady_clock::time_point start;
+
+			/** Shared mapping holding next and workers */
+			void *mapping{nullptr};
+			/** Size of mapping */
+			std::size_t mappingSize{0};
+			/** Index of the next unclaimed key */
+			std::atomic<uint64_t> *next{nullptr};
+			/** Counters of each worker */
+			Worker *workers{nullptr};
+			/** Index of the key from peek(), or SIZE_MAX */
+			std::atomic<std::size_t> peeked{SIZE_MAX};
+		};
+
+		/**
+		 * @brief
+		 * AsyncInterface whose operations read their own image and
+		 * time their own call.
+		 *
+		 * @details
+		 * Images are read on the thread servicing each operation,
+		 * and elapsed time covers only the call into the
+		 * implementation, not time spent queued or reading.
+		 */
+		class TimedAsyncInterface : public AsyncInterface
+		{
+		public:
+			/** Outcome of one operation. */
+			template<typename T>
+			struct Result
+			{
+				/** Image passed to the call */
+				SlapImage image{};
+				/** Value returned from the call */
+				T value{};
+				/** Time spent in the call */
+				std::chrono::microseconds elapsed{};
+			};
+
+			using AsyncInterface::AsyncInterface;
+
+			/**
+			 * @brief
+			 * Queue a read of an image and a call to
+			 * Interface::segment() on it.
+			 *
+			 * @param imageName
+			 * Key from VALIDATION_DATA of the image to segment.
+			 * @param kind
+			 * Kind of image captured.
+			 *
+			 * @return
+			 * Future that will hold the image, the value
+			 * returned from Interface::segment(), and the time
+			 * spent in it.
+			 */
+			std::future<Result<std::tuple<ReturnStatus,
+			    std::vector<SegmentationPosition>>>>
+			segment(
+			    const std::string &imageName,
+			    const SlapImage::Kind kind);
+
+			/**
+			 * @brief
+			 * Queue a read of an image and a call to
+			 * Interface::determineOrientation() on it.
+			 *
+			 * @param imageName
+			 * Key from VALIDATION_DATA of the image.
+			 * @param kind
+			 * Kind of image captured.
+			 *
+			 * @return
+			 * Future that will hold the image, the value
+			 * returned from Interface::determineOrientation(),
+			 * and the time spent in it.
+			 *
+			 * @note
+			 * The orientation of the image is
+			 * default-initialized.
+			 */
+			std::future<Result<std::tuple<ReturnStatus,
+			    SlapImage::Orientation>>>
+			determineOrientation(
+			    const std::string &imageName,
+			    const SlapImage::Kind kind);
+		};
+
+		/**
+		 * @brief
+		 * Reads images on a background thread ahead of their use.
+		 *
+		 * @details
+		 * Keys are claimed from a WorkQueue and their images read
+		 * into a queue of at most `depth` images, so at most
+		 * `depth` + 1 images are held at once.
+		 */
+		class ImagePrefetcher
+		{
+		public:
+			/**
+			 * @brief
+			 * ImagePrefetcher constructor, which starts reading.
+			 *
+			 * @param kind
+			 * Kind of images in keys.
+			 * @param keys
+			 * Queue from which to claim images to read. Must
+			 * outlive this object and not be iterated by others
+			 * in this process.
+			 * @param depth
+			 * Number of images to read ahead (at least 1).
+			 * @param rowPadding
+			 * Padding passed to readImage().
+			 */
+			ImagePrefetcher(
+			    const SlapImage::Kind kind,
+			    WorkQueue &keys,
+			    const uint16_t depth,
+			    const uint16_t rowPadding);
+
+			ImagePrefetcher(
+			    const ImagePrefetcher&) = delete;
+			ImagePrefetcher&
+			operator=(
+			    const ImagePrefetcher&) = delete;
+
+			/** Stops reading and waits for the reader. */
+			~ImagePrefetcher();
+
+			/**
+			 * @brief
+			 * Obtain the next image, waiting if it has not
+			 * been read yet.
+			 *
+			 * @return
+			 * Name and contents of the next image claimed, or
+			 * nothing once `keys` is exhausted.
+			 *
+			 * @throw runtime_error
+			 * Error reading the image.
+			 */
+			std::optional<std::pair<std::string, SlapImage>>
+			next();
+
+			/**
+			 * @return
+			 * Total time next() has spent waiting for images.
+			 */
+			std::chrono::microseconds
+			getStarvedTime()
+			    const;
+
+		private:
+			/** Read every image into the queue. */
+			void
+			read();
+
+			/** Kind of images in keys */
+			const SlapImage::Kind kind;
+			/** Queue of images to read */
+			WorkQueue &keys;
+			/** Maximum size of queue */
+			const std::size_t depth;
+			/** Padding passed to readImage() */
+			const uint16_t rowPadding;
+
+			/** Protects the members below */
+			mutable std::mutex mutex{};
+			/** Signaled when an image or error is queued */
+			std::condition_variable imageQueued{};
+			/** Signaled when an image is dequeued */
+			std::condition_variable imageDequeued{};
+			/** Images read but not yet returned */
+			std::deque<std::pair<std::string, SlapImage>> queue{};
+			/** Error from reading, after the images in queue */
+			std::exception_ptr error{};
+			/** Whether the reader should stop */
+			bool stopping{false};
+			/** Whether every claimed image has been queued */
+			bool finished{false};
+			/** Time next() has spent waiting */
+			std::chrono::steady_clock::duration starved{};
+
+			/** Thread running read() */
+			std::thread reader{};
+		};
+
+		/**
+		 * @brief
+		 * Run an operation on a set of images with processes, then
+		 * again with threads of this process.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII API implementation.
+		 * @param kind
+		 * The kind of images in keys.
+		 * @param keys
+		 * The keys from VALIDATION_DATA to process, in the order
+		 * they are to be claimed.
+		 * @param numProcs
+		 * Number of single-threaded processes to run first.
+		 * @param args
+		 * Arguments parsed from command line. `numThreads` threads
+		 * of one process are run second.
+		 *
+		 * @note
+		 * Wall time of each mode is written to a compare log. Only
+		 * threads write operation logs to the output directory;
+		 * those of processes are written to its `compare`
+		 * subdirectory, so each image is logged once.
+		 */
+		void
+		compareModes(
+		    std::shared_ptr<Interface> impl,
+		    const SlapImage::Kind kind,
+		    const std::vector<std::string> &keys,
+		    const uint16_t numProcs,
+		    const Arguments &args);
+
 		/**
 		 * @brief
 		 * Determine orientation for a single image.
@@ -67,9 +704,13 @@ namespace SlapSegIII
 		 * Metadata regarding the image.
 		 * @param kind
 		 * Kind of image captured.
+		 * @param args
+		 * Arguments controlling the call: latency budget and row
+		 * padding.
 		 *
 		 * @return
-		 * Entry for log file.
+		 * Tuple of entry for orientation log file and entry for
+		 * budget log file (empty when there is no latency budget).
 		 *
 		 * @throw
 		 * Error reading image or error segmenting.
@@ -78,32 +719,458 @@ namespace SlapSegIII
 		 * Note that md.orientation will be default-initialized before
 		 * being passed to the interface.
 		 */
-		std::string
+		std::tuple<std::string, std::string>
 		determineOrientation(
 		    const std::shared_ptr<Interface> impl,
 		    const std::string &imageName,
 		    const ImageMetadata &md,
+		    const SlapImage::Kind kind,
+		    const Arguments &args);
+
+		/**
+		 * @brief
+		 * Determine orientation for a set of images, keeping several
+		 * requests outstanding.
+		 *
+		 * @param async
+		 * Asynchronous interface to SlapSegIII implementation.
+		 * @param kind
+		 * Kind of images captured.
+		 * @param keys
+		 * Queue of keys from VALIDATION_DATA on which to determine
+		 * orientation.
+		 * @param numOutstanding
+		 * Number of requests to keep in flight.
+		 * @param log
+		 * Stream on which to write log file entries.
+		 *
+		 * @throw
+		 * Error reading image, error determining orientation, or
+		 * error writing to log.
+		 *
+		 * @note
+		 * Keys are claimed on this thread, and each image is read and
+		 * timed on the thread of `async` that processes it. Only
+		 * this thread writes to `log`.
+		 */
+		void
+		determineOrientationAsync(
+		    TimedAsyncInterface &async,
+		    const SlapImage::Kind kind,
+		    WorkQueue &keys,
+		    const uint16_t numOutstanding,
+		    std::ostream &log);
+
+		/**
+		 * @brief
+		 * Time the first call a worker makes into an implementation.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII implementation.
+		 * @param imageName
+		 * Name of the image to pass to the call.
+		 * @param kind
+		 * Kind of image captured.
+		 * @param operation
+		 * Operation whose method should be called.
+		 *
+		 * @return
+		 * Entry for first call log file.
+		 *
+		 * @throw
+		 * Error reading image or error from the call.
+		 *
+		 * @note
+		 * The result of the call is not otherwise logged. Timing the
+		 * first call separately keeps one-time costs out of the
+		 * elapsed times of the operation's log.
+		 */
+		std::string
+		firstCall(
+		    const std::shared_ptr<Interface> impl,
+		    const std::string &imageName,
+		    const SlapImage::Kind kind,
+		    const Operation operation);
+
+		/**
+		 * @brief
+		 * Create budget log file entry for a single call.
+		 *
+		 * @param imageName
+		 * Name of the image passed to the call.
+		 * @param elapsedTime
+		 * Time spent in the call.
+		 * @param latencyBudget
+		 * Time the call was allowed to take.
+		 * @param code
+		 * Code returned from the call.
+		 *
+		 * @return
+		 * Entry for log file.
+		 */
+		std::string
+		formatBudget(
+		    const std::string &imageName,
+		    const std::chrono::microseconds elapsedTime,
+		    const std::chrono::milliseconds latencyBudget,
+		    const ReturnStatus::Code code);
+
+		/**
+		 * @brief
+		 * Create log file entry for a single orientation
+		 * determination.
+		 *
+		 * @param imageName
+		 * Name of the image whose orientation was determined.
+		 * @param rv
+		 * Value returned from determining orientation of image.
+		 * @param elapsedTime
+		 * Time spent determining orientation of image.
+		 *
+		 * @return
+		 * Entry for log file.
+		 */
+		std::string
+		formatOrientation(
+		    const std::string &imageName,
+		    const std::tuple<ReturnStatus, SlapImage::Orientation> &rv,
+		    const std::chrono::microseconds elapsedTime);
+
+		/**
+		 * @brief
+		 * Create log file entries for a single segmentation.
+		 *
+		 * @param imageName
+		 * Name of the image that was segmented.
+		 * @param md
+		 * Metadata regarding the image.
+		 * @param image
+		 * The image that was segmented.
+		 * @param rv
+		 * Value returned from segmenting image.
+		 * @param elapsedTime
+		 * Time spent segmenting image.
+		 *
+		 * @return
+		 * Entries for log file.
+		 *
+		 * @throw
+		 * rv violates API requirements.
+		 */
+		std::string
+		formatSegmentation(
+		    const std::string &imageName,
+		    const ImageMetadata &md,
+		    const SlapImage &image,
+		    const std::tuple<ReturnStatus,
+		    std::vector<SegmentationPosition>> &rv,
+		    const std::chrono::microseconds elapsedTime);
+
+		/** CPUs this process may use, and what limits them. */
+		struct CPUBudget
+		{
+			/** Number of CPUs online on the host */
+			uint32_t online{1};
+			/** Number of CPUs in the affinity mask */
+			uint32_t affinity{1};
+			/**
+			 * Smallest cgroup v2 cpu.max quota of this process's
+			 * cgroup and its ancestors, in CPUs (0 if unlimited).
+			 */
+			double quota{0};
+			/** Number of CPUs that workers may occupy */
+			uint32_t budget{1};
+		};
+
+		/**
+		 * @brief
+		 * Obtain the number of CPUs available to this process.
+		 *
+		 * @return
+		 * CPUs available to this process. The budget is the smaller
+		 * of the affinity mask and the whole CPUs in the cgroup
+		 * quota, and at least 1.
+		 *
+		 * @note
+		 * A container's CPU limit is usually enforced through its
+		 * cgroup quota, not its affinity mask, so
+		 * std::thread::hardware_concurrency() overstates it.
+		 */
+		CPUBudget
+		getCPUBudget();
+
+		/**
+		 * @brief
+		 * Obtain the amount of memory available to start processes.
+		 *
+		 * @return
+		 * Available memory in bytes, or 0 if unknown.
+		 */
+		uint64_t
+		getAvailableMemory();
+
+		/**
+		 * @brief
+		 * Obtain memory an implementation needs for a kind of image.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII implementation.
+		 * @param kind
+		 * Kind of images to be processed.
+		 *
+		 * @return
+		 * Largest requirements reported for any resolution of `kind`
+		 * in VALIDATION_DATA.
+		 */
+		ResourceRequirements
+		getKindRequirements(
+		    const std::shared_ptr<Interface> impl,
 		    const SlapImage::Kind kind);
 
 		/**
 		 * @brief
-		 * Parse command line arguments.
+		 * Limit the number of processes to what memory allows.
+		 *
+		 * @param numProcs
+		 * Number of processes requested.
+		 * @param numThreads
+		 * Number of threads calling into each process'
+		 * implementation.
+		 * @param requirements
+		 * Memory the implementation needs to process the images.
+		 * @param availableMemory
+		 * Available memory in bytes, or 0 if unknown.
+		 *
+		 * @return
+		 * `numProcs`, reduced (to no fewer than 1) so that the
+		 * working set and scratch memory of every process fit in
+		 * `availableMemory`.
+		 */
+		uint16_t
+		limitProcsByMemory(
+		    const uint16_t numProcs,
+		    const uint16_t numThreads,
+		    const ResourceRequirements &requirements,
+		    const uint64_t availableMemory);
+
+		/**
+		 * @brief
+		 * Record that memory limited the number of processes.
+		 *
+		 * @param kind
+		 * Kind of images the processes will process.
+		 * @param requested
+		 * Number of processes requested.
+		 * @param allowed
+		 * Number of processes limitProcsByMemory() allowed.
+		 * @param availableMemory
+		 * Available memory in bytes.
+		 * @param warn
+		 * Whether to also print the reduction to stderr, because
+		 * `requested` was given on the command line.
+		 *
+		 * @throw runtime_error
+		 * Error creating or writing to log file.
+		 */
+		void
+		logMemoryLimit(
+		    const SlapImage::Kind kind,
+		    const uint16_t requested,
+		    const uint16_t allowed,
+		    const uint64_t availableMemory,
+		    const bool warn);
+
+		/**
+		 * @brief
+		 * Write the work done by each worker to a log.
+		 *
+		 * @param kind
+		 * Kind of images processed by workers.
+		 * @param workers
+		 * Statistics from runWorkers().
+		 *
+		 * @note
+		 * Each worker's idle time is how long it waited for the
+		 * slowest worker to finish.
+		 */
+		void
+		logWorkers(
+		    const SlapImage::Kind kind,
+		    const std::vector<WorkQueue::WorkerStatistics> &workers);
+
+		/**
+		 * @brief
+		 * Write the throughput of each NUMA node to a log.
+		 *
+		 * @param kind
+		 * Kind of images processed by workers.
+		 * @param workers
+		 * Statistics from runWorkers() of workers bound to nodes.
+		 *
+		 * @note
+		 * A node's elapsed time is that of its slowest worker.
+		 */
+		void
+		logNodeThroughput(
+		    const SlapImage::Kind kind,
+		    const std::vector<WorkQueue::WorkerStatistics> &workers);
+
+		/**
+		 * @brief
+		 * Create a log file in the output directory for this process.
+		 *
+		 * @param prefix
+		 * Prefix of the log file's name.
+		 * @param kind
+		 * Kind of images logged.
+		 * @param header
+		 * First line of the log file.
+		 *
+		 * @return
+		 * Stream for the newly-created log file.
+		 *
+		 * @throw runtime_error
+		 * Error creating or writing to log file.
+		 */
+		std::ofstream
+		openLog(
+		    const std::string &prefix,
+		    const SlapImage::Kind kind,
+		    const std::string &header);
+
+		/**
+		 * @brief
+		 * Create a log file in the output directory for this process,
+		 * not specific to a kind of image.
+		 *
+		 * @param prefix
+		 * Prefix of the log file's name.
+		 * @param header
+		 * First line of the log file.
+		 *
+		 * @return
+		 * Stream for the newly-created log file.
+		 *
+		 * @throw runtime_error
+		 * Error creating or writing to log file.
+		 */
+		std::ofstream
+		openLog(
+		    const std::string &prefix,
+		    const std::string &header);
+
+		/**
+		 * @brief
+		 * Set whether readImage() may return images that reference
+		 * pixels owned elsewhere.
+		 *
+		 * @param enabled
+		 * Whether every implementation images are passed to returns
+		 * true from Interface::supportsPixelViews(). false by
+		 * default.
+		 */
+		void
+		setPixelViews(
+		    const bool enabled);
+
+		/**
+		 * @brief
+		 * Set the directory in which openLog() creates log files.
+		 *
+		 * @param directory
+		 * Existing directory for log files of this process and of
+		 * processes it forks afterwards. `output` by default.
+		 */
+		void
+		setLogDirectory(
+		    const std::filesystem::path &directory);
+
+		/**
+		 * @brief
+		 * Create a shifted, brightness-adjusted copy of an image, as
+		 * a subsequent live-scan frame might appear.
+		 *
+		 * @param image
+		 * Image to copy.
+		 * @param dx
+		 * Number of pixels to shift right (negative for left).
+		 * @param dy
+		 * Number of pixels to shift down (negative for up).
+		 * @param brightness
+		 * Value added to every pixel, saturating.
+		 *
+		 * @return
+		 * Tightly packed copy of `image`, with pixels shifted in from
+		 * outside the image copied from the nearest edge.
+		 */
+		SlapImage
+		jitterImage(
+		    const SlapImage &image,
+		    const int16_t dx,
+		    const int16_t dy,
+		    const int16_t brightness);
+
+		/**
+		 * @brief
+		 * Parse command line arguments.
+		 *
+		 * @param argc
+		 * argc from main().
+		 * @param argv
+		 * argv from main()
+		 *
+		 * @return
+		 * Command line arguments parsed into an Argument.
+		 *
+		 * @throw std::exception
+		 * Errors or inconsistencies when parsing arguments.
+		 */
+		Arguments
+		parseArguments(
+		    int argc,
+		    char *argv[]);
+
+		/**
+		 * @brief
+		 * Determine whether arguments select an option that is only
+		 * implemented for synchronous calls.
+		 *
+		 * @param args
+		 * Parsed command line arguments.
+		 *
+		 * @return
+		 * true if every call must be made from a single thread per
+		 * process, false if calls may be asynchronous.
+		 */
+		bool
+		requiresSynchronousCalls(
+		    const Arguments &args);
+
+		/**
+		 * @brief
+		 * Choose the number of processes and threads per process
+		 * with which to exercise an implementation.
 		 *
-		 * @param argc
-		 * argc from main().
-		 * @param argv
-		 * argv from main()
+		 * @param capabilities
+		 * Concurrency capabilities declared by the implementation.
+		 * @param cpuBudget
+		 * Number of CPUs that workers may occupy.
 		 *
 		 * @return
-		 * Command line arguments parsed into an Argument.
+		 * A tuple whose first member is the number of processes and
+		 * whose second member is the number of threads per process.
 		 *
-		 * @throw std::exception
-		 * Errors or inconsistencies when parsing arguments.
+		 * @note
+		 * Reentrant implementations are shared between threads of as
+		 * few processes as possible. The product of processes,
+		 * threads, and threads used per call does not exceed
+		 * cpuBudget, unless a single call's threads already exceed
+		 * it.
 		 */
-		Arguments
-		parseArguments(
-		    int argc,
-		    char *argv[]);
+		std::tuple<uint16_t, uint16_t>
+		planWorkers(
+		    const ConcurrencyCapabilities &capabilities,
+		    const uint32_t cpuBudget);
 
 		/**
 		 * @brief
@@ -151,13 +1218,73 @@ namespace SlapSegIII
 		 * @param kind
 		 * The kind of images in keys.
 		 * @param keys
-		 * The keys from VALIDATION_DATA to segment.
+		 * Queue of keys from VALIDATION_DATA to segment.
+		 * @param args
+		 * Arguments parsed from command line.
 		 */
 		void
 		runDetermineOrientation(
 		    std::shared_ptr<Interface> impl,
 		    const SlapImage::Kind kind,
-		    const std::vector<std::string> &keys);
+		    WorkQueue &keys,
+		    const Arguments &args);
+
+		/**
+		 * @brief
+		 * Run the operation requested on the command line on a set of
+		 * images.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII API implementation.
+		 * @param kind
+		 * The kind of images in keys.
+		 * @param keys
+		 * Queue of keys from VALIDATION_DATA to process.
+		 * @param args
+		 * Arguments parsed from command line.
+		 *
+		 * @note
+		 * The first key this worker claims from `keys` is first
+		 * passed to firstCall(), then processed as usual. When
+		 * `args.verbose`, the result is logged to a first call log.
+		 *
+		 * @note
+		 * When `args.verbose`, the resident memory and image reads
+		 * of the process are logged to memory and I/O logs after
+		 * all images are processed.
+		 *
+		 * @note
+		 * When calls are synchronous and the implementation declares
+		 * peak scratch memory for `kind`, a ScratchArena of that size
+		 * is provided through Interface::setMemoryResource().
+		 */
+		void
+		runOperation(
+		    std::shared_ptr<Interface> impl,
+		    const SlapImage::Kind kind,
+		    WorkQueue &keys,
+		    const Arguments &args);
+
+		/**
+		 * @brief
+		 * Run a set of combined segmentations and orientation
+		 * determinations.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII API implementation.
+		 * @param kind
+		 * The kind of images in keys.
+		 * @param keys
+		 * Queue of keys from VALIDATION_DATA to segment.
+		 *
+		 * @throw runtime_error
+		 * impl does not support orientation determination.
+		 */
+		void
+		runSegmentAndDetermineOrientation(
+		    std::shared_ptr<Interface> impl,
+		    const SlapImage::Kind kind,
+		    WorkQueue &keys);
 
 		/**
 		 * @brief
@@ -168,30 +1295,91 @@ namespace SlapSegIII
 		 * @param kind
 		 * The kind of images in keys.
 		 * @param keys
-		 * The keys from VALIDATION_DATA to segment.
+		 * Queue of keys from VALIDATION_DATA to segment.
+		 * @param args
+		 * Arguments parsed from command line.
 		 */
 		void
 		runSegment(
 		    std::shared_ptr<Interface> impl,
 		    const SlapImage::Kind kind,
-		    const std::vector<std::string> &keys);
+		    WorkQueue &keys,
+		    const Arguments &args);
+
+		/**
+		 * @brief
+		 * Run an operation on a set of images with one or more
+		 * forked workers.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII API implementation.
+		 * @param kind
+		 * The kind of images in keys.
+		 * @param keys
+		 * The keys from VALIDATION_DATA to process, in the order
+		 * they are to be claimed.
+		 * @param numProcs
+		 * Number of processes to run (1 to run in this process).
+		 * @param args
+		 * Arguments parsed from command line.
+		 *
+		 * @return
+		 * Statistics of each worker.
+		 */
+		std::vector<WorkQueue::WorkerStatistics>
+		runWorkers(
+		    std::shared_ptr<Interface> impl,
+		    const SlapImage::Kind kind,
+		    const std::vector<std::string> &keys,
+		    const uint16_t numProcs,
+		    const Arguments &args);
+
+		/**
+		 * @brief
+		 * Obtain the resident memory of this process.
+		 *
+		 * @return
+		 * Entry for memory log file, from /proc/self/smaps_rollup.
+		 * Fields that cannot be read are logged as NA.
+		 */
+		std::string
+		readMemoryUsage();
 
 		/**
 		 * @brief
-		 * Read a file from disk.
+		 * Read an image from the validation image directory.
 		 *
-		 * @param pathName
-		 * Path to file to read.
+		 * @param imageName
+		 * Name of the image to read.
+		 * @param md
+		 * Metadata regarding the image.
+		 * @param kind
+		 * Kind of image captured.
+		 * @param orientation
+		 * Orientation to record in the returned SlapImage.
+		 * @param rowPadding
+		 * Number of bytes of padding to add after each row. When
+		 * nonzero, the image is placed `rowPadding` / 2 bytes into
+		 * each row of a larger buffer, as a region of interest.
 		 *
 		 * @return
-		 * Contents of pathName as a vector of bytes.
+		 * SlapImage holding the contents of imageName, as read by
+		 * readFile(). Unpadded images read by any backend other
+		 * than IOBackend::Buffered reference its memory in place if
+		 * pixel views were enabled with setPixelViews(), and are
+		 * copied into SlapImage::pixels otherwise.
 		 *
 		 * @throw runtime_error
-		 * Error reading from file.
+		 * Error reading from file, or file contents do not match
+		 * the image's layout.
 		 */
-		std::vector<std::byte>
-		readFile(
-		    const std::string &pathName);
+		SlapImage
+		readImage(
+		    const std::string &imageName,
+		    const ImageMetadata &md,
+		    const SlapImage::Kind kind,
+		    const SlapImage::Orientation orientation,
+		    const uint16_t rowPadding);
 
 		/**
 		 * @brief
@@ -220,40 +1408,253 @@ namespace SlapSegIII
 		 * Metadata regarding the image.
 		 * @param kind
 		 * Kind of image captured.
+		 * @param args
+		 * Arguments controlling the call: latency budget and row
+		 * padding.
 		 *
 		 * @return
-		 * Entry for log file.
+		 * Tuple of entries for segmentation log file and entry for
+		 * budget log file (empty when there is no latency budget).
 		 *
 		 * @throw
 		 * Error reading image or error segmenting.
 		 */
-		std::string
+		std::tuple<std::string, std::string>
+		segment(
+		    const std::shared_ptr<Interface> impl,
+		    const std::string &imageName,
+		    const ImageMetadata &md,
+		    const SlapImage::Kind kind,
+		    const Arguments &args);
+
+		/**
+		 * @brief
+		 * Segment a single image that has already been read.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII implementation.
+		 * @param imageName
+		 * Name of the image to segment.
+		 * @param md
+		 * Metadata regarding the image.
+		 * @param si
+		 * Image read by readImage().
+		 * @param args
+		 * Arguments controlling the call: latency budget.
+		 *
+		 * @return
+		 * Tuple of entries for segmentation log file and entry for
+		 * budget log file (empty when there is no latency budget).
+		 *
+		 * @throw
+		 * Error segmenting.
+		 */
+		std::tuple<std::string, std::string>
 		segment(
 		    const std::shared_ptr<Interface> impl,
 		    const std::string &imageName,
 		    const ImageMetadata &md,
+		    const SlapImage &si,
+		    const Arguments &args);
+
+		/**
+		 * @brief
+		 * Segment a set of images, keeping several requests
+		 * outstanding.
+		 *
+		 * @param async
+		 * Asynchronous interface to SlapSegIII implementation.
+		 * @param kind
+		 * Kind of images captured.
+		 * @param keys
+		 * Queue of keys from VALIDATION_DATA to segment.
+		 * @param numOutstanding
+		 * Number of requests to keep in flight.
+		 * @param log
+		 * Stream on which to write log file entries.
+		 *
+		 * @throw
+		 * Error reading image, error segmenting, or error writing to
+		 * log.
+		 *
+		 * @note
+		 * Keys are claimed on this thread, and each image is read and
+		 * timed on the thread of `async` that processes it. Only
+		 * this thread writes to `log`.
+		 */
+		void
+		segmentAsync(
+		    TimedAsyncInterface &async,
+		    const SlapImage::Kind kind,
+		    WorkQueue &keys,
+		    const uint16_t numOutstanding,
+		    std::ostream &log);
+
+		/**
+		 * @brief
+		 * Segment and determine orientation for a single image with a
+		 * single call.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII implementation.
+		 * @param imageName
+		 * Name of the image to segment.
+		 * @param md
+		 * Metadata regarding the image.
+		 * @param kind
+		 * Kind of image captured.
+		 *
+		 * @return
+		 * A tuple whose first member is the entry for the
+		 * segmentation log file and whose second member is the entry
+		 * for the orientation log file.
+		 *
+		 * @throw
+		 * Error reading image or error segmenting.
+		 *
+		 * @note
+		 * Note that md.orientation will be default-initialized before
+		 * being passed to the interface. Both entries record the
+		 * elapsed time of the combined call.
+		 */
+		std::tuple<std::string, std::string>
+		segmentAndDetermineOrientation(
+		    const std::shared_ptr<Interface> impl,
+		    const std::string &imageName,
+		    const ImageMetadata &md,
+		    const SlapImage::Kind kind);
+
+		/**
+		 * @brief
+		 * Segment several images with a single call.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII implementation.
+		 * @param imageNames
+		 * Names of the images to segment.
+		 * @param kind
+		 * Kind of images captured.
+		 *
+		 * @return
+		 * Entries for log file.
+		 *
+		 * @throw
+		 * Error reading images or error segmenting.
+		 *
+		 * @note
+		 * Each image is logged with an equal share of the time spent
+		 * segmenting the batch.
+		 */
+		std::string
+		segmentBatch(
+		    const std::shared_ptr<Interface> impl,
+		    const std::span<const std::string> imageNames,
 		    const SlapImage::Kind kind);
 
 		/**
 		 * @brief
-		 * Create multiple smaller sets from a large set.
+		 * Segment a single image into caller-owned storage.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII implementation.
+		 * @param imageName
+		 * Name of the image to segment.
+		 * @param md
+		 * Metadata regarding the image.
+		 * @param kind
+		 * Kind of image captured.
+		 * @param positions
+		 * Storage reused by the caller across calls.
+		 *
+		 * @return
+		 * Entries for log file.
+		 *
+		 * @throw
+		 * Error reading image or error segmenting.
+		 */
+		std::string
+		segmentCompact(
+		    const std::shared_ptr<Interface> impl,
+		    const std::string &imageName,
+		    const ImageMetadata &md,
+		    const SlapImage::Kind kind,
+		    CompactSegmentationPositions &positions);
+
+		/**
+		 * @brief
+		 * Segment a sequence of live-scan frames of a single image.
+		 *
+		 * @param impl
+		 * Pointer to SlapSegIII implementation.
+		 * @param imageName
+		 * Name of the image to segment.
+		 * @param md
+		 * Metadata regarding the image.
+		 * @param kind
+		 * Kind of image captured.
+		 * @param args
+		 * Arguments controlling the call: number of frames.
+		 * @param rng
+		 * Random number generator used to jitter frames.
+		 *
+		 * @return
+		 * Tuple of entries for segmentation log file and entries for
+		 * sequence log file.
+		 *
+		 * @throw
+		 * Error reading image or error segmenting.
+		 *
+		 * @note
+		 * `args.numFrames` - 1 jittered copies of the image are passed
+		 * to a single SegmentationSession, followed by the image
+		 * itself, as if the operator accepted the last frame. Only the
+		 * last frame is recorded in the segmentation log.
+		 */
+		std::tuple<std::string, std::string>
+		segmentSequence(
+		    const std::shared_ptr<Interface> impl,
+		    const std::string &imageName,
+		    const ImageMetadata &md,
+		    const SlapImage::Kind kind,
+		    const Arguments &args,
+		    std::mt19937_64 &rng);
+
+		/**
+		 * @brief
+		 * Segment a single image delivered as timed bands of rows.
 		 *
-		 * @param combinedSet
-		 * Set of strings to split.
-		 * @param numSets
-		 * Number of sets to create.
+		 * @param impl
+		 * Pointer to SlapSegIII implementation.
+		 * @param imageName
+		 * Name of the image to segment.
+		 * @param md
+		 * Metadata regarding the image.
+		 * @param kind
+		 * Kind of image captured.
+		 * @param args
+		 * Arguments controlling the call: band size and interval.
 		 *
 		 * @return
-		 * Collection of numSets collections, created sequentially
-		 * from combinedSet.
+		 * Tuple of entries for segmentation log file and entry for
+		 * streaming log file.
 		 *
 		 * @throw
-		 * numSets > combinedSet.size()
+		 * Error reading image or error segmenting.
+		 *
+		 * @note
+		 * Bands are pushed no earlier than `args.bandInterval` apart,
+		 * as a scanner would deliver them. Elapsed time is measured
+		 * from the return of the last call to pushRows() until
+		 * finish() returns, so it excludes any delay in delivering
+		 * bands.
 		 */
-		std::vector<std::vector<std::string>>
-		splitSet(
-		    const std::vector<std::string> &combinedSet,
-		    uint8_t numSets);
+		std::tuple<std::string, std::string>
+		segmentStream(
+		    const std::shared_ptr<Interface> impl,
+		    const std::string &imageName,
+		    const ImageMetadata &md,
+		    const SlapImage::Kind kind,
+		    const Arguments &args);
 
 		/**
 		 * @brief
@@ -268,6 +1669,46 @@ namespace SlapSegIII
 		testOperation(
 		    const Arguments &args);
 
+		/**
+		 * @brief
+		 * Segment all images of each kind with every core library
+		 * named in `args`.
+		 *
+		 * @param args
+		 * Arguments parsed from command line.
+		 *
+		 * @note
+		 * Each library is prepared for the kinds it supports, and
+		 * only passed images of those kinds. Images of a kind are
+		 * read once and passed to each library in turn. Libraries
+		 * are loaded with Plugin, so only Interface::segmentInto()
+		 * is called directly.
+		 */
+		void
+		testPlugins(
+		    const Arguments &args);
+
+		/**
+		 * @brief
+		 * Write percentiles of latencies and throughput to a
+		 * latency log and stdout.
+		 *
+		 * @param histograms
+		 * Latencies recorded by every worker.
+		 * @param kindElapsed
+		 * Wall time taken to run all images of each kind.
+		 *
+		 * @note
+		 * Throughput of a key is its images divided by the wall
+		 * time of its kind, during which images of other keys of
+		 * the same kind were also processed.
+		 */
+		void
+		writeLatencySummary(
+		    const LatencyHistograms &histograms,
+		    const std::map<SlapImage::Kind,
+		    std::chrono::steady_clock::duration> &kindElapsed);
+
 		/**
 		 * @brief
 		 * Wait for forked children to exit.
@@ -277,7 +1718,7 @@ namespace SlapSegIII
 		 */
 		void
 		waitForExit(
-		    const uint8_t numChildren);
+		    const uint16_t numChildren);
 	}
 }
 
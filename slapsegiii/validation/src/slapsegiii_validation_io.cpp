@@ -0,0 +1,640 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#include <slapsegiii_validation_io.h>
+
+namespace
+{
+	/** Backend used by readFile() */
+	SlapSegIII::Validation::IOBackend ioBackend{
+	    SlapSegIII::Validation::IOBackend::Buffered};
+	/** Whether readFile() drops files from the page cache first */
+	bool evictBeforeRead{false};
+	/** Files readFile() serves from memory */
+	std::shared_ptr<const SlapSegIII::Validation::ImageCorpus>
+	    imageCorpus{};
+
+	/** Totals of readFile() calls (see IOStatistics) */
+	std::atomic<uint64_t> filesRead{0};
+	std::atomic<uint64_t> bytesRead{0};
+	std::atomic<int64_t> nanosecondsReading{0};
+
+	/** Alignment of O_DIRECT buffers, offsets, and lengths */
+	constexpr std::size_t DIRECT_ALIGNMENT{4096};
+	/** Alignment of each file within an ImageCorpus */
+	constexpr std::size_t CORPUS_ALIGNMENT{64};
+
+	/** @return Description of errno. */
+	std::string
+	lastError()
+	{
+		return (std::system_error(errno, std::system_category()).
+		    code().message());
+	}
+
+	/** File descriptor, closed when destroyed. */
+	struct FileDescriptor
+	{
+		FileDescriptor(
+		    const std::string &pathName,
+		    const int flags) :
+		    fd{::open(pathName.c_str(), flags)}
+		{
+			if (this->fd == -1)
+				throw std::runtime_error{"Could not open " +
+				    pathName + " (" + lastError() + ")"};
+		}
+
+		FileDescriptor(
+		    const FileDescriptor&) = delete;
+		FileDescriptor&
+		operator=(
+		    const FileDescriptor&) = delete;
+
+		~FileDescriptor()
+		{
+			::close(this->fd);
+		}
+
+		/** @return Size of the file in bytes. */
+		std::size_t
+		size()
+		    const
+		{
+			struct stat sb{};
+			if (::fstat(this->fd, &sb) == -1)
+				throw std::runtime_error{"Could not stat file "
+				    "(" + lastError() + ")"};
+			return (static_cast<std::size_t>(sb.st_size));
+		}
+
+		int fd{-1};
+	};
+
+	/**
+	 * @brief
+	 * Fill `buf` with read(), which may return less than asked.
+	 *
+	 * @return
+	 * Number of bytes read, less than `size` only at end of file.
+	 */
+	std::size_t
+	readFully(
+	    const int fd,
+	    std::byte *buf,
+	    const std::size_t size)
+	{
+		std::size_t offset{0};
+		while (offset < size) {
+			const auto rv = ::read(fd, buf + offset,
+			    size - offset);
+			if (rv == 0)
+				break;
+			if (rv == -1) {
+				if (errno == EINTR)
+					continue;
+				throw std::runtime_error{"Could not read file "
+				    "(" + lastError() + ")"};
+			}
+			offset += static_cast<std::size_t>(rv);
+		}
+
+		return (offset);
+	}
+
+	/**
+	 * A single-entry io_uring, set up with raw system calls so that
+	 * liburing is not required.
+	 */
+	class Ring
+	{
+	public:
+		Ring()
+		{
+			io_uring_params params{};
+			this->fd = static_cast<int>(::syscall(
+			    __NR_io_uring_setup, 1, &params));
+			if (this->fd == -1)
+				throw std::runtime_error{"io_uring is not "
+				    "available (" + lastError() + ")"};
+			try {
+				this->setUp(params);
+			} catch (...) {
+				this->release();
+				throw;
+			}
+		}
+
+		Ring(
+		    const Ring&) = delete;
+		Ring&
+		operator=(
+		    const Ring&) = delete;
+
+		~Ring()
+		{
+			this->release();
+		}
+
+		/**
+		 * @brief
+		 * Read from `file` at `offset` and wait for completion.
+		 *
+		 * @return
+		 * Number of bytes read.
+		 */
+		std::size_t
+		read(
+		    const int file,
+		    std::byte *buf,
+		    const unsigned size,
+		    const uint64_t offset)
+		{
+			/* Only this thread produces, so tail is ours */
+			const unsigned tail{std::atomic_ref<unsigned>(
+			    *this->sqTail).load(std::memory_order_relaxed)};
+			const unsigned index{tail & this->sqMask};
+			io_uring_sqe &sqe = this->sqes[index];
+			std::memset(&sqe, 0, sizeof(sqe));
+			sqe.opcode = IORING_OP_READ;
+			sqe.fd = file;
+			sqe.addr = reinterpret_cast<uint64_t>(buf);
+			sqe.len = size;
+			sqe.off = offset;
+			this->sqArray[index] = index;
+			std::atomic_ref<unsigned>(*this->sqTail).store(
+			    tail + 1, std::memory_order_release);
+
+			unsigned toSubmit{1};
+			const unsigned head{std::atomic_ref<unsigned>(
+			    *this->cqHead).load(std::memory_order_relaxed)};
+			while (std::atomic_ref<unsigned>(*this->cqTail).load(
+			    std::memory_order_acquire) == head) {
+				const auto rv = ::syscall(__NR_io_uring_enter,
+				    this->fd, toSubmit, 1,
+				    IORING_ENTER_GETEVENTS, nullptr, 0);
+				if (rv == -1) {
+					if (errno == EINTR)
+						continue;
+					throw std::runtime_error{"Could not "
+					    "submit to io_uring (" +
+					    lastError() + ")"};
+				}
+				toSubmit -= std::min<unsigned>(toSubmit,
+				    static_cast<unsigned>(rv));
+			}
+
+			const auto res = this->cqes[head & this->cqMask].res;
+			std::atomic_ref<unsigned>(*this->cqHead).store(
+			    head + 1, std::memory_order_release);
+			if (res < 0)
+				throw std::runtime_error{"Could not read file "
+				    "(" + std::system_error(-res,
+				    std::system_category()).code().message() +
+				    ")"};
+
+			return (static_cast<std::size_t>(res));
+		}
+
+		/** Process that set up this ring */
+		const pid_t pid{::getpid()};
+
+	private:
+		/** Map the rings described by `params`. */
+		void
+		setUp(
+		    const io_uring_params &params)
+		{
+			this->sqSize = params.sq_off.array +
+			    (params.sq_entries * sizeof(unsigned));
+			this->cqSize = params.cq_off.cqes +
+			    (params.cq_entries * sizeof(io_uring_cqe));
+			if (params.features & IORING_FEAT_SINGLE_MMAP)
+				this->sqSize = this->cqSize = std::max(
+				    this->sqSize, this->cqSize);
+			this->sqesSize = params.sq_entries *
+			    sizeof(io_uring_sqe);
+
+			this->sq = this->map(this->sqSize, static_cast<off_t>(
+			    IORING_OFF_SQ_RING));
+			this->cq = (params.features & IORING_FEAT_SINGLE_MMAP) ?
+			    this->sq : this->map(this->cqSize,
+			    static_cast<off_t>(IORING_OFF_CQ_RING));
+			this->sqes = static_cast<io_uring_sqe*>(this->map(
+			    this->sqesSize, static_cast<off_t>(
+			    IORING_OFF_SQES)));
+
+			this->sqTail = this->at<unsigned>(this->sq,
+			    params.sq_off.tail);
+			this->sqMask = *this->at<unsigned>(this->sq,
+			    params.sq_off.ring_mask);
+			this->sqArray = this->at<unsigned>(this->sq,
+			    params.sq_off.array);
+			this->cqHead = this->at<unsigned>(this->cq,
+			    params.cq_off.head);
+			this->cqTail = this->at<unsigned>(this->cq,
+			    params.cq_off.tail);
+			this->cqMask = *this->at<unsigned>(this->cq,
+			    params.cq_off.ring_mask);
+			this->cqes = this->at<io_uring_cqe>(this->cq,
+			    params.cq_off.cqes);
+		}
+
+		/** Unmap the rings and close the io_uring. */
+		void
+		release()
+		{
+			if (this->sqes != nullptr)
+				::munmap(this->sqes, this->sqesSize);
+			if ((this->cq != nullptr) && (this->cq != this->sq))
+				::munmap(this->cq, this->cqSize);
+			if (this->sq != nullptr)
+				::munmap(this->sq, this->sqSize);
+			::close(this->fd);
+		}
+
+		void*
+		map(
+		    const std::size_t size,
+		    const off_t offset)
+		{
+			void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+			    MAP_SHARED | MAP_POPULATE, this->fd, offset);
+			if (p == MAP_FAILED)
+				throw std::runtime_error{"Could not map "
+				    "io_uring (" + lastError() + ")"};
+			return (p);
+		}
+
+		template<typename T>
+		static T*
+		at(
+		    void *base,
+		    const uint32_t offset)
+		{
+			return (reinterpret_cast<T*>(static_cast<char*>(base) +
+			    offset));
+		}
+
+		int fd{-1};
+		std::size_t sqSize{0}, cqSize{0}, sqesSize{0};
+		void *sq{nullptr}, *cq{nullptr};
+		io_uring_sqe *sqes{nullptr};
+		unsigned *sqTail{nullptr}, *sqArray{nullptr};
+		unsigned *cqHead{nullptr}, *cqTail{nullptr};
+		unsigned sqMask{0}, cqMask{0};
+		io_uring_cqe *cqes{nullptr};
+	};
+
+	SlapSegIII::Validation::FileContents
+	readBuffered(
+	    const std::string &pathName)
+	{
+		const FileDescriptor file{pathName, O_RDONLY};
+
+		/* SlapImage::pixels is a std::vector, so it is zero-filled */
+		SlapSegIII::Validation::FileContents contents{};
+		contents.buffer.resize(file.size());
+		contents.buffer.resize(readFully(file.fd,
+		    contents.buffer.data(), contents.buffer.size()));
+		return (contents);
+	}
+
+	SlapSegIII::Validation::FileContents
+	readMemoryMapped(
+	    const std::string &pathName)
+	{
+		const FileDescriptor file{pathName, O_RDONLY};
+		const auto size = file.size();
+		if (size == 0)
+			return {};
+
+		/* Fault in every page now, rather than during a call */
+		void *p = ::mmap(nullptr, size, PROT_READ,
+		    MAP_PRIVATE | MAP_POPULATE, file.fd, 0);
+		if (p == MAP_FAILED)
+			throw std::runtime_error{"Could not map " + pathName +
+			    " (" + lastError() + ")"};
+
+		SlapSegIII::Validation::FileContents contents{};
+		contents.view = {static_cast<const std::byte*>(p), size};
+		contents.owner = std::shared_ptr<const void>(p,
+		    [size](const void *mapping) {
+			::munmap(const_cast<void*>(mapping), size);
+		    });
+		return (contents);
+	}
+
+	SlapSegIII::Validation::FileContents
+	readDirect(
+	    const std::string &pathName)
+	{
+		const FileDescriptor file{pathName, O_RDONLY | O_DIRECT};
+		const auto size = file.size();
+
+		/* Reads must cover whole blocks, even past end of file */
+		const std::size_t capacity{((size + DIRECT_ALIGNMENT - 1) /
+		    DIRECT_ALIGNMENT) * DIRECT_ALIGNMENT};
+		std::shared_ptr<std::byte> buf(static_cast<std::byte*>(
+		    ::operator new(std::max(capacity, DIRECT_ALIGNMENT),
+		    std::align_val_t{DIRECT_ALIGNMENT})), [](std::byte *p) {
+			::operator delete(p, std::align_val_t{
+			    DIRECT_ALIGNMENT});
+		    });
+
+		/* Stop at the short read of the last block */
+		std::size_t offset{0};
+		while (offset < size) {
+			const auto rv = ::read(file.fd, buf.get() + offset,
+			    capacity - offset);
+			if (rv == 0)
+				break;
+			if (rv == -1) {
+				if (errno == EINTR)
+					continue;
+				throw std::runtime_error{"Could not read " +
+				    pathName + " (" + lastError() + ")"};
+			}
+			offset += static_cast<std::size_t>(rv);
+		}
+
+		SlapSegIII::Validation::FileContents contents{};
+		contents.view = {buf.get(), std::min(size, offset)};
+		contents.owner = std::move(buf);
+		return (contents);
+	}
+
+	SlapSegIII::Validation::FileContents
+	readIOUring(
+	    const std::string &pathName)
+	{
+		/* Set up once per thread, and again in forked children */
+		thread_local std::unique_ptr<Ring> ring{};
+		if ((ring == nullptr) || (ring->pid != ::getpid()))
+			ring = std::make_unique<Ring>();
+
+		const FileDescriptor file{pathName, O_RDONLY};
+		const auto size = file.size();
+		std::shared_ptr<std::byte[]> buf{
+		    std::make_unique_for_overwrite<std::byte[]>(size)};
+
+		std::size_t offset{0};
+		while (offset < size) {
+			const auto rv = ring->read(file.fd, buf.get() + offset,
+			    static_cast<unsigned>(std::min<std::size_t>(
+			    size - offset, UINT32_MAX)), offset);
+			if (rv == 0)
+				break;
+			offset += rv;
+		}
+
+		SlapSegIII::Validation::FileContents contents{};
+		contents.view = {buf.get(), offset};
+		contents.owner = std::move(buf);
+		return (contents);
+	}
+}
+
+std::span<const std::byte>
+SlapSegIII::Validation::FileContents::getBytes()
+    const
+    noexcept
+{
+	if (this->owner != nullptr)
+		return (this->view);
+	return (this->buffer);
+}
+
+SlapSegIII::Validation::ImageCorpus::ImageCorpus(
+    const std::vector<std::string> &pathNames)
+{
+	/* Lay out every file before creating the mapping */
+	std::vector<std::size_t> offsets{}, sizes{};
+	offsets.reserve(pathNames.size());
+	sizes.reserve(pathNames.size());
+	for (const auto &pathName : pathNames) {
+		std::error_code ec{};
+		sizes.push_back(static_cast<std::size_t>(
+		    std::filesystem::file_size(pathName, ec)));
+		if (ec)
+			throw std::runtime_error{"Could not stat " + pathName +
+			    " (" + ec.message() + ")"};
+		this->totalSize = ((this->totalSize + CORPUS_ALIGNMENT - 1) /
+		    CORPUS_ALIGNMENT) * CORPUS_ALIGNMENT;
+		offsets.push_back(this->totalSize);
+		this->totalSize += sizes.back();
+	}
+	if (this->totalSize == 0)
+		return;
+
+	const int fd{::memfd_create("slapsegiii_corpus",
+	    MFD_CLOEXEC | MFD_ALLOW_SEALING)};
+	if (fd == -1)
+		throw std::runtime_error{"Could not create corpus (" +
+		    lastError() + ")"};
+	const auto size = this->totalSize;
+	void *p{MAP_FAILED};
+	try {
+		if (::ftruncate(fd, static_cast<off_t>(size)) == -1)
+			throw std::runtime_error{"Could not size corpus (" +
+			    lastError() + ")"};
+
+		void *writable = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+		    MAP_SHARED, fd, 0);
+		if (writable == MAP_FAILED)
+			throw std::runtime_error{"Could not map corpus (" +
+			    lastError() + ")"};
+		try {
+			/* Only one file is held outside the corpus at once */
+			for (std::size_t i{0}; i < pathNames.size(); ++i) {
+				const auto contents = readFile(pathNames[i]);
+				const auto bytes = contents.getBytes();
+				if (bytes.size() != sizes[i])
+					throw std::runtime_error{pathNames[i] +
+					    " changed while being read"};
+				std::copy(bytes.begin(), bytes.end(),
+				    static_cast<std::byte*>(writable) +
+				    offsets[i]);
+			}
+		} catch (...) {
+			::munmap(writable, size);
+			throw;
+		}
+		::munmap(writable, size);
+
+		/* No process can modify the corpus after this */
+		if (::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW |
+		    F_SEAL_WRITE | F_SEAL_SEAL) == -1)
+			throw std::runtime_error{"Could not seal corpus (" +
+			    lastError() + ")"};
+		p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED | MAP_POPULATE,
+		    fd, 0);
+		if (p == MAP_FAILED)
+			throw std::runtime_error{"Could not map corpus (" +
+			    lastError() + ")"};
+	} catch (...) {
+		::close(fd);
+		throw;
+	}
+	::close(fd);
+
+	this->mapping = std::shared_ptr<const void>(p,
+	    [size](const void *mapped) {
+		::munmap(const_cast<void*>(mapped), size);
+	    });
+	for (std::size_t i{0}; i < pathNames.size(); ++i)
+		this->files[pathNames[i]] = {static_cast<const std::byte*>(p) +
+		    offsets[i], sizes[i]};
+}
+
+SlapSegIII::Validation::FileContents
+SlapSegIII::Validation::ImageCorpus::find(
+    const std::string &pathName)
+    const
+{
+	const auto it = this->files.find(pathName);
+	if (it == this->files.cend())
+		return {};
+
+	FileContents contents{};
+	contents.view = it->second;
+	contents.owner = this->mapping;
+	return (contents);
+}
+
+std::size_t
+SlapSegIII::Validation::ImageCorpus::size()
+    const
+    noexcept
+{
+	return (this->totalSize);
+}
+
+void
+SlapSegIII::Validation::setImageCorpus(
+    std::shared_ptr<const ImageCorpus> corpus)
+{
+	imageCorpus = std::move(corpus);
+}
+
+void
+SlapSegIII::Validation::setIOBackend(
+    const IOBackend backend,
+    const bool evict)
+{
+	ioBackend = backend;
+	evictBeforeRead = evict;
+}
+
+SlapSegIII::Validation::FileContents
+SlapSegIII::Validation::readFile(
+    const std::string &pathName)
+{
+	if (imageCorpus != nullptr) {
+		auto contents = imageCorpus->find(pathName);
+		if (contents.owner != nullptr)
+			return (contents);
+	}
+
+	if (evictBeforeRead) {
+		const FileDescriptor file{pathName, O_RDONLY};
+		::posix_fadvise(file.fd, 0, 0, POSIX_FADV_DONTNEED);
+	}
+
+	FileContents contents{};
+	const auto start = std::chrono::steady_clock::now();
+	switch (ioBackend) {
+	case IOBackend::Buffered:
+		contents = readBuffered(pathName);
+		break;
+	case IOBackend::MemoryMapped:
+		contents = readMemoryMapped(pathName);
+		break;
+	case IOBackend::Direct:
+		contents = readDirect(pathName);
+		break;
+	case IOBackend::IOUring:
+		contents = readIOUring(pathName);
+		break;
+	}
+	const auto stop = std::chrono::steady_clock::now();
+
+	++filesRead;
+	bytesRead += contents.getBytes().size();
+	nanosecondsReading += std::chrono::duration_cast<
+	    std::chrono::nanoseconds>(stop - start).count();
+
+	return (contents);
+}
+
+SlapSegIII::Validation::IOStatistics
+SlapSegIII::Validation::getIOStatistics()
+{
+	return {filesRead, bytesRead,
+	    std::chrono::nanoseconds(nanosecondsReading)};
+}
+
+void
+SlapSegIII::Validation::resetIOStatistics()
+{
+	filesRead = 0;
+	bytesRead = 0;
+	nanosecondsReading = 0;
+}
+
+std::string
+SlapSegIII::Validation::formatIOStatistics()
+{
+	static const char *names[]{"buffered", "mmap", "direct", "uring"};
+
+	const auto stats = getIOStatistics();
+	const auto seconds = std::chrono::duration<double>(
+	    stats.elapsed).count();
+	return (std::string(names[static_cast<std::size_t>(ioBackend)]) +
+	    ',' + std::to_string(evictBeforeRead) + ',' +
+	    std::to_string(stats.files) + ',' + std::to_string(stats.bytes) +
+	    ',' + std::to_string(std::chrono::duration_cast<
+	    std::chrono::microseconds>(stats.elapsed).count()) + ',' +
+	    (seconds > 0 ? std::to_string(static_cast<uint64_t>(
+	    static_cast<double>(stats.bytes) / seconds)) : "NA") + '\n');
+}
+
+SlapSegIII::Validation::IOBackend
+SlapSegIII::Validation::parseIOBackend(
+    const std::string &name)
+{
+	if (name == "buffered")
+		return (IOBackend::Buffered);
+	if (name == "mmap")
+		return (IOBackend::MemoryMapped);
+	if (name == "direct")
+		return (IOBackend::Direct);
+	if (name == "uring")
+		return (IOBackend::IOUring);
+
+	throw std::invalid_argument{"Unknown I/O backend \"" + name + "\""};
+}
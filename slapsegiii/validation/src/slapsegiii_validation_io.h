@@ -0,0 +1,220 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#ifndef SLAPSEGIII_VALIDATION_IO_H_
+#define SLAPSEGIII_VALIDATION_IO_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SlapSegIII
+{
+	namespace Validation
+	{
+		/** Ways of reading a file into memory. */
+		enum class IOBackend
+		{
+			/** read() into a std::vector */
+			Buffered,
+			/** mmap() with MAP_POPULATE, used in place */
+			MemoryMapped,
+			/** O_DIRECT read() into an aligned buffer */
+			Direct,
+			/** Reads submitted through io_uring */
+			IOUring
+		};
+
+		/** Contents of a file read by readFile(). */
+		struct FileContents
+		{
+			/** Contents, when read by IOBackend::Buffered */
+			std::vector<std::byte> buffer{};
+			/** Contents, when read by any other IOBackend */
+			std::span<const std::byte> view{};
+			/** Keeps the memory referenced by `view` alive */
+			std::shared_ptr<const void> owner{};
+
+			/** @return Contents, wherever they are stored. */
+			std::span<const std::byte>
+			getBytes()
+			    const
+			    noexcept;
+		};
+
+		/** Totals of calls to readFile() in this process. */
+		struct IOStatistics
+		{
+			/** Number of files read */
+			uint64_t files{0};
+			/** Number of bytes read */
+			uint64_t bytes{0};
+			/** Time spent opening and reading files */
+			std::chrono::nanoseconds elapsed{0};
+		};
+
+		/**
+		 * @brief
+		 * Files read into one shared, read-only mapping.
+		 *
+		 * @details
+		 * Contents are written to a sealed memfd and mapped
+		 * MAP_SHARED, so processes forked after construction
+		 * share a single copy of every file.
+		 */
+		class ImageCorpus
+		{
+		public:
+			/**
+			 * @brief
+			 * ImageCorpus constructor.
+			 *
+			 * @param pathNames
+			 * Paths of files to read with readFile().
+			 *
+			 * @throw runtime_error
+			 * Error reading a file or creating the mapping.
+			 */
+			ImageCorpus(
+			    const std::vector<std::string> &pathNames);
+
+			/**
+			 * @brief
+			 * Obtain the contents of a file in this corpus.
+			 *
+			 * @param pathName
+			 * Path passed to the constructor.
+			 *
+			 * @return
+			 * Contents referencing the mapping, or empty
+			 * contents if pathName is not in this corpus.
+			 */
+			FileContents
+			find(
+			    const std::string &pathName)
+			    const;
+
+			/** @return Total bytes of all files. */
+			std::size_t
+			size()
+			    const
+			    noexcept;
+
+		private:
+			/** Shared, read-only mapping of all files */
+			std::shared_ptr<const void> mapping{};
+			/** Contents of each file within mapping */
+			std::map<std::string, std::span<const std::byte>>
+			    files{};
+			/** Total bytes of all files */
+			std::size_t totalSize{0};
+		};
+
+		/**
+		 * @brief
+		 * Serve readFile() from a corpus instead of from disk.
+		 *
+		 * @param corpus
+		 * Corpus consulted by readFile(), or nullptr to always
+		 * read from disk.
+		 *
+		 * @note
+		 * Not thread-safe. Call before any threads read files.
+		 */
+		void
+		setImageCorpus(
+		    std::shared_ptr<const ImageCorpus> corpus);
+
+		/**
+		 * @brief
+		 * Choose how readFile() reads files.
+		 *
+		 * @param backend
+		 * Backend used by readFile().
+		 * @param evict
+		 * Whether to drop each file from the page cache before
+		 * reading it, so reads come from storage.
+		 *
+		 * @note
+		 * Not thread-safe. Call before any threads read files.
+		 */
+		void
+		setIOBackend(
+		    const IOBackend backend,
+		    const bool evict);
+
+		/**
+		 * @brief
+		 * Read a file from disk with the backend chosen by
+		 * setIOBackend() (IOBackend::Buffered by default).
+		 *
+		 * @details
+		 * Files in the corpus set by setImageCorpus() are not read,
+		 * and are not counted by getIOStatistics().
+		 *
+		 * @param pathName
+		 * Path to file to read.
+		 *
+		 * @return
+		 * Contents of pathName.
+		 *
+		 * @throw runtime_error
+		 * Error reading from file, or backend not supported by the
+		 * file system or kernel.
+		 */
+		FileContents
+		readFile(
+		    const std::string &pathName);
+
+		/**
+		 * @return
+		 * Totals of calls to readFile() since the last call to
+		 * resetIOStatistics().
+		 */
+		IOStatistics
+		getIOStatistics();
+
+		/** Set totals returned by getIOStatistics() to zero. */
+		void
+		resetIOStatistics();
+
+		/**
+		 * @return
+		 * Log line describing the backend chosen by setIOBackend()
+		 * and the totals returned by getIOStatistics().
+		 */
+		std::string
+		formatIOStatistics();
+
+		/**
+		 * @brief
+		 * Convert a command-line name to an IOBackend.
+		 *
+		 * @param name
+		 * One of `buffered`, `mmap`, `direct`, or `uring`.
+		 *
+		 * @return
+		 * IOBackend named by `name`.
+		 *
+		 * @throw invalid_argument
+		 * Unknown name.
+		 */
+		IOBackend
+		parseIOBackend(
+		    const std::string &name);
+	}
+}
+
+#endif /* SLAPSEGIII_VALIDATION_IO_H_ */
@@ -0,0 +1,179 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#include <slapsegiii_validation_latency.h>
+
+namespace
+{
+	/** Histograms recordLatency() counts in */
+	std::shared_ptr<SlapSegIII::Validation::LatencyHistograms>
+	    latencyHistograms{};
+}
+
+SlapSegIII::Validation::LatencyHistograms::LatencyHistograms(
+    const std::vector<LatencyKey> &keys)
+{
+	static_assert(std::atomic<uint64_t>::is_always_lock_free,
+	    "Atomics in shared memory must be lock-free");
+
+	std::vector<LatencyKey> unique{keys};
+	std::sort(unique.begin(), unique.end());
+	unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+	/* Shared, so latencies from forked children are seen by all */
+	this->mappingSize = std::max<std::size_t>(1, unique.size()) *
+	    sizeof(Histogram);
+	this->mapping = ::mmap(nullptr, this->mappingSize,
+	    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (this->mapping == MAP_FAILED)
+		throw std::runtime_error{"Could not map latency histograms (" +
+		    std::system_error(errno, std::system_category()).code().
+		    message() + ")"};
+
+	auto histogram = new (this->mapping) Histogram[unique.size()]{};
+	for (const auto &key : unique)
+		this->histograms.emplace(key, histogram++);
+}
+
+SlapSegIII::Validation::LatencyHistograms::~LatencyHistograms()
+{
+	::munmap(this->mapping, this->mappingSize);
+}
+
+std::size_t
+SlapSegIII::Validation::LatencyHistograms::getIndex(
+    const uint64_t value)
+    noexcept
+{
+	/* Magnitudes above 2^SUB_BUCKET_BITS drop their low bits */
+	const auto clamped = std::min<uint64_t>(value,
+	    (uint64_t{1} << MAX_BITS) - 1);
+	const auto magnitude = static_cast<unsigned>(std::bit_width(clamped));
+	const unsigned shift{magnitude > SUB_BUCKET_BITS ?
+	    magnitude - SUB_BUCKET_BITS : 0};
+
+	return ((static_cast<std::size_t>(shift) << (SUB_BUCKET_BITS - 1)) +
+	    static_cast<std::size_t>(clamped >> shift));
+}
+
+uint64_t
+SlapSegIII::Validation::LatencyHistograms::getHighestValue(
+    const std::size_t index)
+    noexcept
+{
+	constexpr std::size_t subBuckets{std::size_t{1} << SUB_BUCKET_BITS};
+	const std::size_t shift{index < subBuckets ? 0 :
+	    (index >> (SUB_BUCKET_BITS - 1)) - 1};
+	const std::size_t subBucket{index - (shift << (SUB_BUCKET_BITS - 1))};
+
+	return (((static_cast<uint64_t>(subBucket) + 1) << shift) - 1);
+}
+
+void
+SlapSegIII::Validation::LatencyHistograms::record(
+    const LatencyKey &key,
+    const std::chrono::microseconds elapsed)
+    noexcept
+{
+	const auto it = this->histograms.find(key);
+	if (it == this->histograms.end())
+		return;
+
+	const auto value = static_cast<uint64_t>(std::max<
+	    std::chrono::microseconds::rep>(0, elapsed.count()));
+	auto &histogram = *(it->second);
+	histogram.counts[getIndex(value)].fetch_add(1,
+	    std::memory_order_relaxed);
+	histogram.count.fetch_add(1, std::memory_order_relaxed);
+
+	auto max = histogram.max.load(std::memory_order_relaxed);
+	while ((value > max) && !histogram.max.compare_exchange_weak(max,
+	    value, std::memory_order_relaxed));
+}
+
+std::vector<SlapSegIII::Validation::LatencyKey>
+SlapSegIII::Validation::LatencyHistograms::getKeys()
+    const
+{
+	std::vector<LatencyKey> keys{};
+	keys.reserve(this->histograms.size());
+	for (const auto &[key, histogram] : this->histograms)
+		keys.push_back(key);
+
+	return (keys);
+}
+
+SlapSegIII::Validation::LatencySummary
+SlapSegIII::Validation::LatencyHistograms::summarize(
+    const LatencyKey &key)
+    const
+{
+	const auto &histogram = *(this->histograms.at(key));
+
+	/* Read counts once, so percentiles agree with each other */
+	std::vector<uint64_t> counts(NUM_COUNTS);
+	uint64_t total{0};
+	for (std::size_t i{0}; i < NUM_COUNTS; ++i)
+		total += (counts[i] = histogram.counts[i].load());
+	const auto max = histogram.max.load();
+
+	LatencySummary summary{};
+	summary.count = total;
+	summary.max = std::chrono::microseconds(max);
+	if (total == 0)
+		return (summary);
+
+	/* Value at or below which `percentile` of latencies fall */
+	const auto percentile = [&](const double p) {
+		const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(
+		    std::ceil(p / 100.0 * static_cast<double>(total))));
+		uint64_t seen{0};
+		for (std::size_t i{0}; i < NUM_COUNTS; ++i) {
+			seen += counts[i];
+			if (seen >= rank)
+				return (std::chrono::microseconds(
+				    static_cast<std::chrono::microseconds::rep>(
+				    std::min(getHighestValue(i), max))));
+		}
+		return (summary.max);
+	};
+	summary.p50 = percentile(50);
+	summary.p90 = percentile(90);
+	summary.p99 = percentile(99);
+	summary.p999 = percentile(99.9);
+
+	return (summary);
+}
+
+void
+SlapSegIII::Validation::setLatencyHistograms(
+    std::shared_ptr<LatencyHistograms> histograms)
+{
+	latencyHistograms = std::move(histograms);
+}
+
+void
+SlapSegIII::Validation::recordLatency(
+    const LatencyKey &key,
+    const std::chrono::microseconds elapsed)
+    noexcept
+{
+	if (latencyHistograms != nullptr)
+		latencyHistograms->record(key, elapsed);
+}
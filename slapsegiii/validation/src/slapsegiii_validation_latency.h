@@ -0,0 +1,207 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#ifndef SLAPSEGIII_VALIDATION_LATENCY_H_
+#define SLAPSEGIII_VALIDATION_LATENCY_H_
+
+#include <atomic>
+#include <chrono>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <slapsegiii.h>
+
+namespace SlapSegIII
+{
+	namespace Validation
+	{
+		/** Images whose latencies are counted together. */
+		struct LatencyKey
+		{
+			/** Kind of image */
+			SlapImage::Kind kind{};
+			/** Resolution of image in pixels per inch */
+			uint16_t ppi{};
+			/** Technology used to capture the image */
+			SlapImage::CaptureTechnology captureTechnology{};
+
+			auto
+			operator<=>(
+			    const LatencyKey&)
+			    const = default;
+		};
+
+		/** Percentiles of the latencies recorded for a LatencyKey. */
+		struct LatencySummary
+		{
+			/** Number of latencies recorded */
+			uint64_t count{0};
+			/** Median */
+			std::chrono::microseconds p50{};
+			/** 90th percentile */
+			std::chrono::microseconds p90{};
+			/** 99th percentile */
+			std::chrono::microseconds p99{};
+			/** 99.9th percentile */
+			std::chrono::microseconds p999{};
+			/** Largest latency */
+			std::chrono::microseconds max{};
+		};
+
+		/**
+		 * @brief
+		 * Histograms of call latency, shared between processes.
+		 *
+		 * @details
+		 * Each histogram has 64 linear buckets per power of two
+		 * (128 below 128 us), so percentiles are reported to
+		 * within 1/64 of their value with constant memory.
+		 * Counters live in a MAP_SHARED mapping, so latencies
+		 * recorded by processes forked after construction are
+		 * merged without further work.
+		 */
+		class LatencyHistograms
+		{
+		public:
+			/**
+			 * @brief
+			 * LatencyHistograms constructor.
+			 *
+			 * @param keys
+			 * Keys to keep a histogram for.
+			 *
+			 * @throw runtime_error
+			 * Shared memory could not be mapped.
+			 */
+			LatencyHistograms(
+			    const std::vector<LatencyKey> &keys);
+
+			LatencyHistograms(
+			    const LatencyHistograms&) = delete;
+			LatencyHistograms&
+			operator=(
+			    const LatencyHistograms&) = delete;
+
+			~LatencyHistograms();
+
+			/**
+			 * @brief
+			 * Count one latency.
+			 *
+			 * @param key
+			 * Images the latency was measured on. Ignored if
+			 * not passed to the constructor.
+			 * @param elapsed
+			 * Latency to count. Values beyond about 25 days are
+			 * counted as 25 days.
+			 *
+			 * @note
+			 * Thread-safe.
+			 */
+			void
+			record(
+			    const LatencyKey &key,
+			    const std::chrono::microseconds elapsed)
+			    noexcept;
+
+			/** @return Keys passed to the constructor. */
+			std::vector<LatencyKey>
+			getKeys()
+			    const;
+
+			/**
+			 * @param key
+			 * Key passed to the constructor.
+			 *
+			 * @return
+			 * Percentiles of latencies recorded for `key`, each
+			 * the highest value of its bucket (but no more
+			 * than the largest latency).
+			 */
+			LatencySummary
+			summarize(
+			    const LatencyKey &key)
+			    const;
+
+		private:
+			/** Buckets with full resolution at every magnitude */
+			static constexpr unsigned SUB_BUCKET_BITS{7};
+			/** Largest magnitude counted, as a power of two */
+			static constexpr unsigned MAX_BITS{41};
+			/** Number of counters in each histogram */
+			static constexpr std::size_t NUM_COUNTS{
+			    ((MAX_BITS - SUB_BUCKET_BITS) <<
+			    (SUB_BUCKET_BITS - 1)) + (1U << SUB_BUCKET_BITS)};
+
+			/** Histogram in shared memory */
+			struct Histogram
+			{
+				std::atomic<uint64_t> count{0};
+				std::atomic<uint64_t> max{0};
+				std::atomic<uint64_t> counts[NUM_COUNTS]{};
+			};
+
+			/** @return Index of the counter for `value`. */
+			static std::size_t
+			getIndex(
+			    const uint64_t value)
+			    noexcept;
+
+			/** @return Largest value counted at `index`. */
+			static uint64_t
+			getHighestValue(
+			    const std::size_t index)
+			    noexcept;
+
+			/** Shared mapping holding every Histogram */
+			void *mapping{nullptr};
+			/** Size of mapping */
+			std::size_t mappingSize{0};
+			/** Histogram of each key within mapping */
+			std::map<LatencyKey, Histogram*> histograms{};
+		};
+
+		/**
+		 * @brief
+		 * Count latencies passed to recordLatency() in histograms.
+		 *
+		 * @param histograms
+		 * Histograms to count in, or nullptr to stop counting.
+		 *
+		 * @note
+		 * Not thread-safe. Call before any threads record latencies.
+		 */
+		void
+		setLatencyHistograms(
+		    std::shared_ptr<LatencyHistograms> histograms);
+
+		/**
+		 * @brief
+		 * Count a latency in the histograms set by
+		 * setLatencyHistograms(), if any.
+		 *
+		 * @param key
+		 * Images the latency was measured on.
+		 * @param elapsed
+		 * Latency to count.
+		 */
+		void
+		recordLatency(
+		    const LatencyKey &key,
+		    const std::chrono::microseconds elapsed)
+		    noexcept;
+	}
+}
+
+#endif /* SLAPSEGIII_VALIDATION_LATENCY_H_ */
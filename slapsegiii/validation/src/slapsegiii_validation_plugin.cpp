@@ -0,0 +1,218 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <dlfcn.h>
+
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include <slapsegiii_validation_plugin.h>
+
+namespace
+{
+	/**
+	 * Mangled name of Interface::getImplementation() under the
+	 * Itanium C++ ABI with the C++11 libstdc++ ABI.
+	 */
+	const char GET_IMPLEMENTATION_SYMBOL[]{"_ZN10SlapSegIII9Interface17"
+	    "getImplementationERKNSt10filesystem7__cxx114pathE"};
+
+	/** Signature of Interface::getImplementation(). */
+	using GetImplementation = std::shared_ptr<SlapSegIII::Interface>(*)(
+	    const std::filesystem::path&);
+
+	/**
+	 * @brief
+	 * Make a call into an implementation.
+	 *
+	 * @param isolated
+	 * Whether the implementation is in its own link-map namespace.
+	 * @param call
+	 * Call to make.
+	 *
+	 * @return
+	 * Result of `call`.
+	 *
+	 * @note
+	 * An exception thrown from an isolated library belongs to that
+	 * library's runtime and cannot be safely caught and destroyed by
+	 * ours, so std::terminate() is called instead of propagating it.
+	 */
+	template<typename Call>
+	auto
+	callLibrary(
+	    const bool isolated,
+	    Call &&call)
+	{
+		if (!isolated)
+			return (call());
+
+		try {
+			return (call());
+		} catch (...) {
+			std::terminate();
+		}
+	}
+
+	/**
+	 * @brief
+	 * Copy the result of a call into an implementation.
+	 *
+	 * @param isolated
+	 * Whether the implementation is in its own link-map namespace.
+	 * @param call
+	 * Call whose result to copy.
+	 *
+	 * @return
+	 * Copy of the result of `call`, in memory owned by this side.
+	 *
+	 * @note
+	 * Memory owned by a result from an isolated library was allocated
+	 * from its heap, so that result is never destroyed here. Each call
+	 * leaks that memory, so only make infrequent calls this way.
+	 */
+	template<typename Result, typename Call>
+	Result
+	copyResult(
+	    const bool isolated,
+	    Call &&call)
+	{
+		if (!isolated)
+			return (call());
+
+		alignas(Result) std::byte storage[sizeof(Result)];
+		const auto *result = ::new (static_cast<void*>(storage))
+		    Result(callLibrary(isolated, std::forward<Call>(call)));
+		return (Result{*result});
+	}
+
+	/** @return Last dlerror() message, or a placeholder. */
+	std::string
+	lastError()
+	{
+		const char *error = dlerror();
+		return (error == nullptr ? "unknown error" : error);
+	}
+}
+
+SlapSegIII::Validation::Plugin::Plugin(
+    const std::filesystem::path &path,
+    const std::filesystem::path &configDir,
+    const bool isolate) :
+    path{path},
+    configDir{configDir}
+{
+	if (isolate) {
+		this->handle = dlmopen(LM_ID_NEWLM, path.c_str(),
+		    RTLD_NOW | RTLD_LOCAL);
+		this->isolated = (this->handle != nullptr);
+	}
+	/* Namespaces are limited, so share ours if none are left */
+	if (this->handle == nullptr)
+		this->handle = dlopen(path.c_str(),
+		    RTLD_NOW | RTLD_LOCAL | RTLD_DEEPBIND);
+	if (this->handle == nullptr)
+		throw std::runtime_error{"Could not load " + path.string() +
+		    " (" + lastError() + ")"};
+
+	dlerror();
+	if (dlsym(this->handle, GET_IMPLEMENTATION_SYMBOL) == nullptr) {
+		const auto error = lastError();
+		dlclose(this->handle);
+		throw std::runtime_error{path.string() + " does not define "
+		    "Interface::getImplementation() (" + error + ")"};
+	}
+}
+
+SlapSegIII::Validation::Plugin::~Plugin()
+{
+	/* Copies would call into code that dlclose() unmaps */
+	const bool shared{this->implementation.use_count() > 1};
+	this->implementation.reset();
+	if (!shared)
+		dlclose(this->handle);
+}
+
+std::shared_ptr<SlapSegIII::Interface>
+SlapSegIII::Validation::Plugin::getImplementation()
+{
+	if (this->implementation == nullptr) {
+		const auto getImplementation = reinterpret_cast<
+		    GetImplementation>(dlsym(this->handle,
+		    GET_IMPLEMENTATION_SYMBOL));
+		this->implementation = callLibrary(this->isolated, [&]() {
+			return (getImplementation(this->configDir));
+		});
+		if (this->implementation == nullptr)
+			throw std::runtime_error{this->path.string() + ": "
+			    "getImplementation() returned nullptr"};
+	}
+
+	return (this->implementation);
+}
+
+std::set<SlapSegIII::SlapImage::Kind>
+SlapSegIII::Validation::Plugin::getSupportedKinds()
+{
+	const auto impl = this->getImplementation();
+	return (std::get<0>(copyResult<std::tuple<std::set<SlapImage::Kind>,
+	    bool>>(this->isolated, [&]() { return (impl->getSupported()); })));
+}
+
+bool
+SlapSegIII::Validation::Plugin::supportsPixelViews()
+{
+	const auto impl = this->getImplementation();
+	return (callLibrary(this->isolated,
+	    [&]() { return (impl->supportsPixelViews()); }));
+}
+
+SlapSegIII::ReturnStatus
+SlapSegIII::Validation::Plugin::prepare(
+    const std::set<SlapImage::Kind> &kinds)
+{
+	const auto impl = this->getImplementation();
+	return (copyResult<ReturnStatus>(this->isolated,
+	    [&]() { return (impl->prepare(kinds)); }));
+}
+
+SlapSegIII::CompactReturnStatus
+SlapSegIII::Validation::Plugin::segmentInto(
+    const SlapImage &image,
+    CompactSegmentationPositions &positions)
+{
+	const auto impl = this->getImplementation();
+	/* Result owns no memory, so it is not copied */
+	return (callLibrary(this->isolated,
+	    [&]() { return (impl->segmentInto(image, positions)); }));
+}
+
+std::string
+SlapSegIII::Validation::Plugin::getName()
+    const
+{
+	static const std::string prefix{"libslapsegiii_"};
+
+	std::string name{this->path.stem().string()};
+	if (name.starts_with(prefix))
+		name.erase(0, prefix.size());
+	return (name);
+}
+
+bool
+SlapSegIII::Validation::Plugin::isIsolated()
+    const
+    noexcept
+{
+	return (this->isolated);
+}
@@ -0,0 +1,190 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#ifndef SLAPSEGIII_VALIDATION_PLUGIN_H_
+#define SLAPSEGIII_VALIDATION_PLUGIN_H_
+
+#include <filesystem>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <slapsegiii.h>
+
+namespace SlapSegIII
+{
+	namespace Validation
+	{
+		/**
+		 * @brief
+		 * A core library loaded at runtime.
+		 *
+		 * @details
+		 * Libraries are loaded into their own link-map namespace
+		 * with dlmopen(), so that libraries exporting the same
+		 * symbols (including the core library linked to this
+		 * executable) do not bind to one another.
+		 *
+		 * @warning
+		 * Each namespace has its own copy of the C and C++ runtimes,
+		 * and therefore its own heap. Memory allocated on one side
+		 * must not be freed on the other, so calls into an isolated
+		 * implementation are only made through methods of this
+		 * class. Images passed to it must have their pyramid levels
+		 * built beforehand. An exception thrown from an isolated
+		 * library could only be caught and destroyed by this side's
+		 * runtime, so it calls std::terminate() instead.
+		 */
+		class Plugin
+		{
+		public:
+			/**
+			 * @brief
+			 * Plugin constructor.
+			 *
+			 * @param path
+			 * Path to a core library.
+			 * @param configDir
+			 * Configuration directory passed to
+			 * Interface::getImplementation().
+			 * @param isolate
+			 * Whether to load the library into a new link-map
+			 * namespace. Falls back to dlopen() if that fails.
+			 *
+			 * @note
+			 * Dependencies of an isolated library are found
+			 * through its own RUNPATH and LD_LIBRARY_PATH, not
+			 * through this executable's RUNPATH.
+			 *
+			 * @throw std::runtime_error
+			 * Library could not be loaded or does not define
+			 * Interface::getImplementation().
+			 */
+			Plugin(
+			    const std::filesystem::path &path,
+			    const std::filesystem::path &configDir,
+			    const bool isolate = true);
+
+			Plugin(
+			    const Plugin&) = delete;
+			Plugin&
+			operator=(
+			    const Plugin&) = delete;
+
+			/**
+			 * @brief
+			 * Plugin destructor.
+			 *
+			 * @note
+			 * The library is only unloaded if no copies of the
+			 * implementation remain.
+			 */
+			~Plugin();
+
+			/**
+			 * @brief
+			 * Obtain the library's implementation.
+			 *
+			 * @return
+			 * Implementation, created on first call and shared
+			 * by later calls.
+			 *
+			 * @note
+			 * Only call methods of an isolated implementation
+			 * through this class.
+			 */
+			std::shared_ptr<Interface>
+			getImplementation();
+
+			/**
+			 * @brief
+			 * Obtain the kinds of images the library supports.
+			 *
+			 * @return
+			 * Kinds from Interface::getSupported(), in memory
+			 * owned by this side.
+			 */
+			std::set<SlapImage::Kind>
+			getSupportedKinds();
+
+			/**
+			 * @return
+			 * Result of Interface::supportsPixelViews().
+			 */
+			bool
+			supportsPixelViews();
+
+			/**
+			 * @brief
+			 * Prepare the library to process images.
+			 *
+			 * @param kinds
+			 * Kinds of images that will be processed.
+			 *
+			 * @return
+			 * Result of Interface::prepare(), in memory owned
+			 * by this side.
+			 */
+			ReturnStatus
+			prepare(
+			    const std::set<SlapImage::Kind> &kinds);
+
+			/**
+			 * @brief
+			 * Segment an image with the library.
+			 *
+			 * @param image
+			 * Image to segment.
+			 * @param positions
+			 * Storage for the positions found.
+			 *
+			 * @return
+			 * Result of Interface::segmentInto().
+			 */
+			CompactReturnStatus
+			segmentInto(
+			    const SlapImage &image,
+			    CompactSegmentationPositions &positions);
+
+			/**
+			 * @return
+			 * Library name without the `libslapsegiii_` prefix
+			 * and suffix (e.g., `nullimpl_0001`).
+			 */
+			std::string
+			getName()
+			    const;
+
+			/**
+			 * @return
+			 * Whether the library was loaded into its own
+			 * link-map namespace.
+			 */
+			bool
+			isIsolated()
+			    const
+			    noexcept;
+
+		private:
+			/** Path to the library */
+			std::filesystem::path path{};
+			/** Configuration directory of the library */
+			std::filesystem::path configDir{};
+			/** Handle from dlmopen() or dlopen() */
+			void *handle{nullptr};
+			/** Whether handle is in its own namespace */
+			bool isolated{false};
+			/** Implementation from the library */
+			std::shared_ptr<Interface> implementation{};
+		};
+	}
+}
+
+#endif /* SLAPSEGIII_VALIDATION_PLUGIN_H_ */
@@ -0,0 +1,360 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+
+#include <slapsegiii_validation_topology.h>
+
+namespace
+{
+	/** @return Number of CPUs a mask must be able to hold. */
+	std::size_t
+	getMaskCPUs()
+	{
+		/* Masks may name CPUs that are not online */
+		return (static_cast<std::size_t>(std::max<long>(CPU_SETSIZE,
+		    sysconf(_SC_NPROCESSORS_CONF))));
+	}
+
+	/** Frees a mask from CPU_ALLOC(), which may be a macro. */
+	struct FreeMask
+	{
+		void
+		operator()(
+		    cpu_set_t *mask)
+		    const
+		{
+			CPU_FREE(mask);
+		}
+	};
+
+	/** Owner of a mask from CPU_ALLOC(). */
+	using CPUMask = std::unique_ptr<cpu_set_t, FreeMask>;
+
+	/** @return Empty mask able to hold getMaskCPUs() CPUs. */
+	CPUMask
+	allocateMask()
+	{
+		CPUMask mask{CPU_ALLOC(getMaskCPUs())};
+		if (mask == nullptr)
+			throw std::runtime_error{"Could not allocate CPU mask"};
+		CPU_ZERO_S(CPU_ALLOC_SIZE(getMaskCPUs()), mask.get());
+
+		return (mask);
+	}
+
+	/**
+	 * @return
+	 * Integer in a sysfs topology file of `cpu`, or `fallback` if
+	 * it could not be read.
+	 */
+	uint32_t
+	readTopology(
+	    const uint32_t cpu,
+	    const std::string &name,
+	    const uint32_t fallback)
+	{
+		std::ifstream file{"/sys/devices/system/cpu/cpu" +
+		    std::to_string(cpu) + "/topology/" + name};
+		int64_t value{};
+		if (!(file >> value) || (value < 0))
+			return (fallback);
+		return (static_cast<uint32_t>(value));
+	}
+
+	/** @return NUMA node holding `cpu`, or 0 if unknown. */
+	uint32_t
+	readNode(
+	    const uint32_t cpu)
+	{
+		/* sysfs links each CPU to its node as cpuN/nodeM */
+		std::error_code ec{};
+		for (const auto &entry : std::filesystem::directory_iterator(
+		    "/sys/devices/system/cpu/cpu" + std::to_string(cpu), ec)) {
+			const auto name = entry.path().filename().string();
+			if (!name.starts_with("node") || (name.size() == 4) ||
+			    !std::all_of(name.begin() + 4, name.end(),
+			    [](const char c) { return ((c >= '0') &&
+			    (c <= '9')); }))
+				continue;
+			try {
+				return (static_cast<uint32_t>(std::stoul(
+				    name.substr(4))));
+			} catch (const std::exception&) {
+				return (0);
+			}
+		}
+
+		return (0);
+	}
+}
+
+std::vector<uint32_t>
+SlapSegIII::Validation::getAffinity()
+{
+	const auto mask = allocateMask();
+	const auto maskSize = CPU_ALLOC_SIZE(getMaskCPUs());
+	if (sched_getaffinity(0, maskSize, mask.get()) != 0)
+		throw std::runtime_error{"Could not read CPU affinity (" +
+		    std::system_error(errno, std::system_category()).code().
+		    message() + ")"};
+
+	std::vector<uint32_t> cpus{};
+	for (std::size_t cpu{0}; cpu < getMaskCPUs(); ++cpu)
+		if (CPU_ISSET_S(cpu, maskSize, mask.get()))
+			cpus.push_back(static_cast<uint32_t>(cpu));
+
+	return (cpus);
+}
+
+void
+SlapSegIII::Validation::setAffinity(
+    const std::vector<uint32_t> &cpus)
+{
+	const auto mask = allocateMask();
+	const auto maskSize = CPU_ALLOC_SIZE(getMaskCPUs());
+	for (const auto &cpu : cpus)
+		CPU_SET_S(cpu, maskSize, mask.get());
+
+	if (sched_setaffinity(0, maskSize, mask.get()) != 0)
+		throw std::runtime_error{"Could not set CPU affinity to " +
+		    formatCPUList(cpus) + " (" + std::system_error(errno,
+		    std::system_category()).code().message() + ")"};
+}
+
+void
+SlapSegIII::Validation::setMemoryNode(
+    const int32_t node)
+{
+	/* No libnuma dependency, so make the system call ourselves */
+	long rv{};
+	if (node < 0) {
+		rv = syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+	} else {
+		constexpr std::size_t bitsPerLong{sizeof(unsigned long) *
+		    CHAR_BIT};
+		const auto bit = static_cast<std::size_t>(node);
+		std::vector<unsigned long> mask((bit / bitsPerLong) + 1);
+		mask[bit / bitsPerLong] = 1UL << (bit % bitsPerLong);
+
+		/* Kernel reads one bit fewer than maxnode */
+		rv = syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(),
+		    (mask.size() * bitsPerLong) + 1);
+	}
+	if (rv != 0)
+		throw std::runtime_error{"Could not set memory policy to "
+		    "node " + std::to_string(node) + " (" + std::system_error(
+		    errno, std::system_category()).code().message() + ")"};
+}
+
+std::vector<SlapSegIII::Validation::LogicalCPU>
+SlapSegIII::Validation::getCPUTopology()
+{
+	std::vector<LogicalCPU> topology{};
+	for (const auto &id : getAffinity()) {
+		/* Core IDs repeat across packages, so key on both */
+		topology.push_back({id,
+		    readTopology(id, "physical_package_id", 0),
+		    readTopology(id, "core_id", UINT32_MAX - id),
+		    readNode(id)});
+	}
+
+	return (topology);
+}
+
+std::vector<uint32_t>
+SlapSegIII::Validation::orderCPUs(
+    const std::vector<LogicalCPU> &cpus,
+    const Placement placement)
+{
+	if (placement == Placement::None)
+		return {};
+
+	/* Rank hardware threads within each core, and cores within each
+	 * package, both by ascending ID */
+	std::map<std::tuple<uint32_t, uint32_t>, std::vector<uint32_t>>
+	    threads{};
+	for (const auto &cpu : cpus)
+		threads[{cpu.package, cpu.core}].push_back(cpu.id);
+	std::map<uint32_t, uint32_t> coresSeen{};
+	std::map<std::tuple<uint32_t, uint32_t>, uint32_t> coreRank{};
+	for (auto &[core, ids] : threads) {
+		std::sort(ids.begin(), ids.end());
+		coreRank[core] = coresSeen[std::get<0>(core)]++;
+	}
+
+	/* Sort keys: most significant first */
+	std::vector<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>>
+	    keys{};
+	for (const auto &[core, ids] : threads) {
+		const auto package = std::get<0>(core);
+		for (uint32_t thread{0}; thread < ids.size(); ++thread) {
+			switch (placement) {
+			case Placement::Compact:
+				keys.emplace_back(package, coreRank[core],
+				    thread, ids[thread]);
+				break;
+			case Placement::Scatter:
+				keys.emplace_back(thread, coreRank[core],
+				    package, ids[thread]);
+				break;
+			case Placement::NoSMT:
+				if (thread == 0)
+					keys.emplace_back(package,
+					    coreRank[core], 0, ids[thread]);
+				break;
+			case Placement::None:
+				break;
+			}
+		}
+	}
+	std::sort(keys.begin(), keys.end());
+
+	std::vector<uint32_t> order{};
+	order.reserve(keys.size());
+	for (const auto &key : keys)
+		order.push_back(std::get<3>(key));
+
+	return (order);
+}
+
+std::vector<uint32_t>
+SlapSegIII::Validation::assignCPUs(
+    const std::vector<uint32_t> &order,
+    const uint16_t worker,
+    const uint16_t count)
+{
+	std::vector<uint32_t> cpus{};
+	if (order.empty())
+		return (cpus);
+
+	const std::size_t first{static_cast<std::size_t>(worker) *
+	    std::max<uint16_t>(1, count)};
+	for (std::size_t i{0}; i < std::max<uint16_t>(1, count); ++i) {
+		const auto cpu = order[(first + i) % order.size()];
+		if (std::find(cpus.begin(), cpus.end(), cpu) == cpus.end())
+			cpus.push_back(cpu);
+	}
+
+	return (cpus);
+}
+
+std::vector<SlapSegIII::Validation::WorkerPlacement>
+SlapSegIII::Validation::placeWorkers(
+    const std::vector<LogicalCPU> &cpus,
+    const Placement placement,
+    const bool bindNodes,
+    const uint16_t numWorkers,
+    const uint16_t cpusPerWorker)
+{
+	std::vector<WorkerPlacement> placements(numWorkers);
+	if (!bindNodes) {
+		const auto order = orderCPUs(cpus, placement);
+		for (uint16_t worker{0}; worker < numWorkers; ++worker)
+			placements[worker].cpus = assignCPUs(order, worker,
+			    cpusPerWorker);
+		return (placements);
+	}
+
+	std::map<uint32_t, std::vector<LogicalCPU>> nodes{};
+	for (const auto &cpu : cpus)
+		nodes[cpu.node].push_back(cpu);
+	if (nodes.empty())
+		return (placements);
+
+	/* Deal workers to nodes in turn, then place within each node */
+	std::vector<uint32_t> nodeIDs{};
+	std::vector<std::vector<uint32_t>> orders{};
+	for (const auto &[node, nodeCPUs] : nodes) {
+		nodeIDs.push_back(node);
+		if (placement == Placement::None) {
+			orders.emplace_back();
+			for (const auto &cpu : nodeCPUs)
+				orders.back().push_back(cpu.id);
+		} else {
+			orders.push_back(orderCPUs(nodeCPUs, placement));
+		}
+	}
+	for (uint16_t worker{0}; worker < numWorkers; ++worker) {
+		const auto n = worker % nodeIDs.size();
+		placements[worker].node = static_cast<int32_t>(nodeIDs[n]);
+		if (placement == Placement::None)
+			placements[worker].cpus = orders[n];
+		else
+			placements[worker].cpus = assignCPUs(orders[n],
+			    static_cast<uint16_t>(worker / nodeIDs.size()),
+			    cpusPerWorker);
+	}
+
+	return (placements);
+}
+
+void
+SlapSegIII::Validation::applyPlacement(
+    const WorkerPlacement &placement)
+{
+	if (!placement.cpus.empty())
+		setAffinity(placement.cpus);
+	if (placement.node >= 0)
+		setMemoryNode(placement.node);
+}
+
+std::string
+SlapSegIII::Validation::formatCPUList(
+    std::vector<uint32_t> cpus)
+{
+	std::sort(cpus.begin(), cpus.end());
+
+	std::string list{};
+	for (std::size_t i{0}; i < cpus.size(); ) {
+		/* Extend a run of consecutive CPUs as far as it goes */
+		std::size_t last{i};
+		while ((last + 1 < cpus.size()) &&
+		    (cpus[last + 1] == cpus[last] + 1))
+			++last;
+
+		if (!list.empty())
+			list += ',';
+		list += std::to_string(cpus[i]);
+		if (last != i)
+			list += '-' + std::to_string(cpus[last]);
+		i = last + 1;
+	}
+
+	return (list);
+}
+
+SlapSegIII::Validation::Placement
+SlapSegIII::Validation::parsePlacement(
+    const std::string &name)
+{
+	if (name == "compact")
+		return (Placement::Compact);
+	if (name == "scatter")
+		return (Placement::Scatter);
+	if (name == "nosmt")
+		return (Placement::NoSMT);
+
+	throw std::invalid_argument{"Unknown placement \"" + name + "\""};
+}
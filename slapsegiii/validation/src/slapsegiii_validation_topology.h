@@ -0,0 +1,221 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#ifndef SLAPSEGIII_VALIDATION_TOPOLOGY_H_
+#define SLAPSEGIII_VALIDATION_TOPOLOGY_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SlapSegIII
+{
+	namespace Validation
+	{
+		/** Ways of assigning CPUs to workers. */
+		enum class Placement
+		{
+			/** Leave workers unpinned */
+			None,
+			/** Fill every hardware thread of a core first */
+			Compact,
+			/** Spread across packages, then cores, then threads */
+			Scatter,
+			/** Use one hardware thread of each core */
+			NoSMT
+		};
+
+		/** A CPU that this process may run on. */
+		struct LogicalCPU
+		{
+			/** Number the kernel uses for this CPU */
+			uint32_t id{0};
+			/** Physical package (socket) holding this CPU */
+			uint32_t package{0};
+			/** Core within package holding this CPU */
+			uint32_t core{0};
+			/** NUMA node holding this CPU */
+			uint32_t node{0};
+		};
+
+		/** Where one worker runs and allocates memory. */
+		struct WorkerPlacement
+		{
+			/** CPUs to run on (empty to leave unpinned) */
+			std::vector<uint32_t> cpus{};
+			/** NUMA node to allocate from (-1 for any node) */
+			int32_t node{-1};
+		};
+
+		/**
+		 * @return
+		 * CPUs in the affinity mask of the calling thread, in
+		 * ascending order.
+		 *
+		 * @throw runtime_error
+		 * Affinity mask could not be read.
+		 */
+		std::vector<uint32_t>
+		getAffinity();
+
+		/**
+		 * @brief
+		 * Restrict the calling thread, and threads it later
+		 * creates, to some CPUs.
+		 *
+		 * @param cpus
+		 * CPUs to run on.
+		 *
+		 * @throw runtime_error
+		 * Affinity mask could not be set.
+		 */
+		void
+		setAffinity(
+		    const std::vector<uint32_t> &cpus);
+
+		/**
+		 * @brief
+		 * Prefer memory from one NUMA node for pages the calling
+		 * thread, and threads it later creates, first touch.
+		 *
+		 * @param node
+		 * NUMA node to allocate from, or -1 to restore the default
+		 * policy of allocating from the node of the touching CPU.
+		 *
+		 * @note
+		 * Other nodes are still used once `node` is exhausted.
+		 *
+		 * @throw runtime_error
+		 * Memory policy could not be set.
+		 */
+		void
+		setMemoryNode(
+		    const int32_t node);
+
+		/**
+		 * @return
+		 * Topology of CPUs returned by getAffinity(), from sysfs.
+		 * CPUs without topology information are placed in package
+		 * 0 and node 0, on a core of their own.
+		 */
+		std::vector<LogicalCPU>
+		getCPUTopology();
+
+		/**
+		 * @brief
+		 * Order CPUs to be handed out to workers.
+		 *
+		 * @param cpus
+		 * CPUs that may be used, from getCPUTopology().
+		 * @param placement
+		 * How workers should be spread across cpus.
+		 *
+		 * @return
+		 * IDs of CPUs, in the order they should be assigned (empty
+		 * for Placement::None).
+		 */
+		std::vector<uint32_t>
+		orderCPUs(
+		    const std::vector<LogicalCPU> &cpus,
+		    const Placement placement);
+
+		/**
+		 * @brief
+		 * Obtain the CPUs of one worker.
+		 *
+		 * @param order
+		 * CPUs from orderCPUs().
+		 * @param worker
+		 * Index of the worker.
+		 * @param count
+		 * Number of CPUs each worker is given (e.g., its number of
+		 * threads).
+		 *
+		 * @return
+		 * The worker's `count` CPUs from `order`, wrapping around
+		 * when there are more workers than CPUs.
+		 */
+		std::vector<uint32_t>
+		assignCPUs(
+		    const std::vector<uint32_t> &order,
+		    const uint16_t worker,
+		    const uint16_t count);
+
+		/**
+		 * @brief
+		 * Decide where each worker runs.
+		 *
+		 * @param cpus
+		 * CPUs that may be used, from getCPUTopology().
+		 * @param placement
+		 * How workers should be spread across CPUs.
+		 * @param bindNodes
+		 * Whether to assign workers to NUMA nodes in turn, running
+		 * each on CPUs of its node and allocating from its node.
+		 * @param numWorkers
+		 * Number of workers.
+		 * @param cpusPerWorker
+		 * Number of CPUs each worker is given (e.g., its number of
+		 * threads). Ignored when workers are bound to a node but
+		 * not placed, as they then run on all of its CPUs.
+		 *
+		 * @return
+		 * Placement of each worker.
+		 */
+		std::vector<WorkerPlacement>
+		placeWorkers(
+		    const std::vector<LogicalCPU> &cpus,
+		    const Placement placement,
+		    const bool bindNodes,
+		    const uint16_t numWorkers,
+		    const uint16_t cpusPerWorker);
+
+		/**
+		 * @brief
+		 * Move the calling thread to a worker's placement.
+		 *
+		 * @param placement
+		 * Placement from placeWorkers().
+		 *
+		 * @throw runtime_error
+		 * Affinity or memory policy could not be set.
+		 */
+		void
+		applyPlacement(
+		    const WorkerPlacement &placement);
+
+		/**
+		 * @return
+		 * `cpus` in the kernel's list format (e.g., `0-3,8`).
+		 */
+		std::string
+		formatCPUList(
+		    std::vector<uint32_t> cpus);
+
+		/**
+		 * @brief
+		 * Convert a command-line name to a Placement.
+		 *
+		 * @param name
+		 * One of `compact`, `scatter`, or `nosmt`.
+		 *
+		 * @return
+		 * Placement named by `name`.
+		 *
+		 * @throw invalid_argument
+		 * Unknown name.
+		 */
+		Placement
+		parsePlacement(
+		    const std::string &name);
+	}
+}
+
+#endif /* SLAPSEGIII_VALIDATION_TOPOLOGY_H_ */
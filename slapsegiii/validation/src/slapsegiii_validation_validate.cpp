@@ -15,7 +15,7 @@
 SlapSegIII::Validation::Validate::Errors
 SlapSegIII::Validation::Validate::validateSegmentationPosition(
     const SegmentationPosition &position,
-    std::shared_ptr<SlapImage> slapImage)
+    const SlapImage &slapImage)
 {
 	/* Don't validate coordinates if position was not set. */
 	if (position.result.code != SegmentationPosition::Result::Code::Success)
@@ -27,19 +27,19 @@ SlapSegIII::Validation::Validate::validateSegmentationPosition(
 		errors.set(
 		    static_cast<typename std::underlying_type<ErrorCode>::type>(
 		    ErrorCode::IrregularCoordinates));
-	if (!isRectangular(position, slapImage->kind))
+	if (!isRectangular(position, slapImage.kind))
 		errors.set(
 		    static_cast<typename std::underlying_type<ErrorCode>::type>(
 		    ErrorCode::NonRectangularCoordinates));
 
-	if (!canBeRotated(slapImage->kind)) {
+	if (!canBeRotated(slapImage.kind)) {
 		if (isRotated(position))
 			errors.set(
 			    static_cast<typename
 			        std::underlying_type<ErrorCode>::type>(
 			        ErrorCode::Rotated));
-		if (isOutsideImage(position, slapImage->width,
-		    slapImage->height))
+		if (isOutsideImage(position, slapImage.width,
+		    slapImage.height))
 			errors.set(static_cast<typename
 			    std::underlying_type<ErrorCode>::type>(
 			    ErrorCode::CoordinatesOutsideImage));
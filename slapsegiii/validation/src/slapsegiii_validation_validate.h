@@ -99,7 +99,7 @@ namespace SlapSegIII
 			Errors
 			validateSegmentationPosition(
 			    const SegmentationPosition &position,
-			    std::shared_ptr<SlapImage> slapImage);
+			    const SlapImage &slapImage);
 
 			/**
 			 * @brief